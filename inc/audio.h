@@ -0,0 +1,105 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SDL2/SDL.h>
+#include "maze.h"
+#include "weapon_sprites.h"
+
+#define AUDIO_RATE 44100      /* Output sample rate */
+#define AUDIO_SAMPLES 512     /* Frames per callback, about 12 ms */
+#define AUDIO_VOICES 16       /* Sounds mixed at once */
+#define AUDIO_QUEUE_SIZE 64   /* Commands in flight; must be a power of 2 */
+#define AUDIO_ROLLOFF 0.35f   /* Gain is 1 / (1 + AUDIO_ROLLOFF * cells) */
+#define AUDIO_DEFAULT_VOLUME 80
+
+/* Sounds, indices into Audio.sounds */
+#define SOUND_SHOT 0   /* Player fires */
+#define SOUND_HIT 1    /* A bullet hits an enemy */
+#define SOUND_ATTACK 2 /* An enemy attacks the player */
+#define SOUND_DEATH 3  /* An enemy dies */
+#define SOUND_COUNT 4
+#define SOUND_ALL 0xFF /* Every sound, for AUDIO_STOP */
+
+/* Commands from the game thread to the mixer */
+#define AUDIO_PLAY 0   /* Start a sound at a gain per channel */
+#define AUDIO_STOP 1   /* Cut every voice playing a sound */
+#define AUDIO_VOLUME 2 /* Set the master volume */
+
+/**
+ * struct Sound - Mono PCM decoded, here synthesized, at startup
+ * @pcm: Samples at AUDIO_RATE
+ * @length: Number of samples
+ */
+typedef struct Sound
+{
+	Sint16 *pcm;
+	int length;
+} Sound;
+
+/**
+ * struct Voice - One sound being mixed
+ * @sound: Sound, or NULL for a free voice
+ * @pos: Next sample to mix
+ * @left: Gain on the left channel
+ * @right: Gain on the right channel
+ */
+typedef struct Voice
+{
+	const Sound *sound;
+	int pos;
+	float left;
+	float right;
+} Voice;
+
+/**
+ * struct AudioCommand - A request from the game thread to the mixer
+ * @type: AUDIO_PLAY, AUDIO_STOP or AUDIO_VOLUME
+ * @sound: SOUND_* to play or stop, or SOUND_ALL
+ * @left: Left gain to play at, or the master volume
+ * @right: Right gain to play at
+ */
+typedef struct AudioCommand
+{
+	Uint8 type;
+	Uint8 sound;
+	float left;
+	float right;
+} AudioCommand;
+
+/**
+ * struct Audio - Sound output mixed on SDL's audio thread
+ * @device: Open audio device, 0 when silent
+ * @sounds: Sounds by SOUND_* number
+ * @voices: Voices being mixed; only the audio callback touches them
+ * @volume: Master volume; only the audio callback touches it
+ * @commands: Ring of commands from the game thread
+ * @head: Commands pushed so far; only the game thread writes it
+ * @tail: Commands applied so far; only the audio callback writes it
+ * @dropped: Commands dropped because the ring was full
+ *
+ * The game thread only pushes commands and the callback only pops them,
+ * so neither ever waits for the other: a full ring drops the command,
+ * and the callback applies what has arrived before each buffer it mixes.
+ */
+typedef struct Audio
+{
+	SDL_AudioDeviceID device;
+	Sound sounds[SOUND_COUNT];
+	Voice voices[AUDIO_VOICES];
+	float volume;
+	AudioCommand commands[AUDIO_QUEUE_SIZE];
+	SDL_atomic_t head;
+	SDL_atomic_t tail;
+	SDL_atomic_t dropped;
+} Audio;
+
+int audio_open(Audio *audio, int volume);
+void audio_close(Audio *audio);
+void audio_play(Audio *audio, int sound, float x, float y,
+	const Player *listener);
+void audio_stop(Audio *audio, int sound);
+void audio_volume(Audio *audio, int volume);
+int sounds_build(Sound *sounds);
+void sounds_free(Sound *sounds);
+
+#endif /* AUDIO_H */
@@ -0,0 +1,121 @@
+#ifndef BEHAVIOUR_H
+#define BEHAVIOUR_H
+
+#include <SDL2/SDL.h>
+
+struct Enemy;
+
+/* Events a behaviour can wait for; signalled by the entity merges */
+#define BEHAVIOUR_HURT 0x01    /* Hit by a bullet */
+#define BEHAVIOUR_NEAR 0x02    /* Came within AI_NEAR cells, in sight */
+#define BEHAVIOUR_ARRIVED 0x04 /* Reached its goal */
+#define BEHAVIOUR_START 0x08   /* Script (re)started */
+#define BEHAVIOUR_TIMER 0x40   /* The wait's time ran out */
+#define BEHAVIOUR_READY 0x80   /* Woken, runs at the end of this tick */
+
+/* Scripts, indices into behaviour_scripts[] */
+#define BEHAVIOUR_CHASE 0    /* Chases the player whenever in sight */
+#define BEHAVIOUR_PATROL 1   /* Walks to and fro until the player comes */
+#define BEHAVIOUR_AMBUSH 2   /* Waits still until the player comes */
+#define BEHAVIOUR_SKIRMISH 3 /* Chases, falls back for a while when hit */
+#define BEHAVIOUR_SCRIPTS 4
+
+/* What an enemy does between resumes of its script */
+#define ENEMY_CHASE 0 /* Moves towards the player in sight and attacks */
+#define ENEMY_HOLD 1  /* Stays put, facing the player in sight */
+#define ENEMY_GOTO 2  /* Moves towards its goal, seen or not */
+#define ENEMY_FLEE 3  /* Moves away from the player in sight */
+
+#define SCHED_WHEEL 256    /* Timer wheel slots, one tick each */
+#define BEHAVIOUR_DONE 1   /* Resume point of a script that returned */
+#define PATROL_TIMEOUT 4000 /* ms a patrol leg may take before turning */
+#define SKIRMISH_FALLBACK 1500 /* ms a skirmisher falls back when hit */
+
+/*
+ * Scripts are stackless coroutines: the resume point is the source line
+ * of the wait it is suspended in, and a switch jumps back there. Locals
+ * do not survive a wait; whatever must is kept in the Behaviour or the
+ * enemy. A wait returns from the script, so one may only appear in the
+ * script function itself, never in a helper it calls.
+ */
+#define CO_BEGIN(co) switch ((co)->line) { case 0:
+#define CO_END(co) } (co)->line = BEHAVIOUR_DONE; (co)->wait = 0
+#define CO_WAIT(co, events, ms) \
+	do { \
+		(co)->line = __LINE__; \
+		(co)->wait = (events); \
+		(co)->wake = (ms); \
+		return; \
+	case __LINE__:; \
+	} while (0)
+#define CO_SLEEP(co, ms) CO_WAIT(co, 0, ms)
+#define CO_WAIT_UNTIL(co, condition, poll_ms) \
+	while (!(condition)) \
+		CO_SLEEP(co, poll_ms)
+#define CO_WOKEN_BY(co, events) ((co)->wait & (events))
+
+/**
+ * struct Behaviour - Coroutine state of one enemy's script
+ * @wake: Tick its timer runs out, 0 for none; a script sets the wait in
+ * ms and the scheduler turns it into a tick
+ * @x: Point the script keeps across waits, X
+ * @y: Point the script keeps across waits, Y
+ * @line: Resume point, 0 to start, BEHAVIOUR_DONE once it returned
+ * @script: BEHAVIOUR_* script it runs
+ * @wait: While suspended, the events that wake it; once woken,
+ * BEHAVIOUR_READY and the events that did
+ *
+ * Sixteen bytes with no padding, so an array of them hashes as is.
+ */
+typedef struct Behaviour
+{
+	Uint32 wake;
+	float x;
+	float y;
+	Uint16 line;
+	Uint8 script;
+	Uint8 wait;
+} Behaviour;
+
+/**
+ * BehaviourScript - Runs a script until its next wait
+ * @co: Coroutine state
+ * @enemy: Enemy the script drives, through its mode and goal
+ */
+typedef void (*BehaviourScript)(Behaviour *co, struct Enemy *enemy);
+
+/**
+ * struct Scheduler - One tick's view of the behaviours of a set of enemies
+ * @behaviours: Per enemy, its coroutine
+ * @count: Length of @behaviours
+ * @next: Per behaviour, next one in its wheel slot, or -1
+ * @prev: Per behaviour, previous one in its wheel slot, or -1 for the head
+ * @wheel: SCHED_WHEEL list heads; a timer for tick t is in t % SCHED_WHEEL
+ * @ready: Behaviours woken this tick, in wake order
+ * @ready_count: Entries in @ready
+ *
+ * A suspended behaviour costs nothing per tick: one waiting for an event
+ * is on no list at all and is found by index when the event is
+ * signalled, and one waiting for time is looked at only when its wheel
+ * slot comes round.
+ */
+typedef struct Scheduler
+{
+	Behaviour *behaviours;
+	int count;
+	int *next;
+	int *prev;
+	int *wheel;
+	int *ready;
+	int *ready_count;
+} Scheduler;
+
+extern const BehaviourScript behaviour_scripts[BEHAVIOUR_SCRIPTS];
+
+void scheduler_reset(Scheduler *scheduler);
+void scheduler_signal(Scheduler *scheduler, int i, Uint8 events);
+int scheduler_run(Scheduler *scheduler, struct Enemy *enemies, Uint32 tick,
+	Uint32 tick_ms);
+int run_behaviour_bench(int count);
+
+#endif /* BEHAVIOUR_H */
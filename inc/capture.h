@@ -0,0 +1,77 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include "maze.h"
+
+#define CAPTURE_SLOTS 8   /* Frames the writer thread may fall behind by */
+#define CAPTURE_FPS 60    /* Frame rate written to the .y4m header */
+
+/**
+ * enum CaptureFormat - Output container of a recording
+ * @CAPTURE_Y4M: YUV4MPEG2 with 4:2:0 chroma (playable by ffmpeg/mpv)
+ * @CAPTURE_RGB: Headerless packed RGB24 frames
+ */
+enum CaptureFormat
+{
+	CAPTURE_Y4M,
+	CAPTURE_RGB
+};
+
+/**
+ * struct Capture - Ring of framebuffers streamed to disk by a writer thread
+ * @file: Output file, owned by the writer thread once started
+ * @format: Output container
+ * @width: Frame width in pixels
+ * @height: Frame height in pixels
+ * @slots: Frame buffers the renderer draws into directly
+ * @slot_width: Render width each slot was drawn at
+ * @slot_height: Render height each slot was drawn at
+ * @head: Frames submitted by the render thread
+ * @tail: Frames written by the writer thread
+ * @ready: Counts submitted frames not yet picked up by the writer
+ * @running: Cleared to ask the writer thread to drain and exit
+ * @thread: Writer thread
+ * @scratch: Writer-owned conversion buffer (YUV planes or RGB24)
+ * @resized: Writer-owned buffer frames rendered below full size are
+ * upscaled into, so the video keeps a constant size
+ * @acquired: 1 if the current frame is being rendered into a slot
+ * @frames_written: Frames written to disk
+ * @frames_dropped: Frames not recorded because the ring was full
+ * @overhead_ticks: Performance counter ticks spent in acquire/submit
+ *
+ * The renderer writes each frame straight into a free slot, so handing a
+ * frame to the writer costs no copy; only the slot index is published.
+ */
+typedef struct Capture
+{
+	FILE *file;
+	enum CaptureFormat format;
+	int width;
+	int height;
+	Uint32 *slots[CAPTURE_SLOTS];
+	int slot_width[CAPTURE_SLOTS];
+	int slot_height[CAPTURE_SLOTS];
+	SDL_atomic_t head;
+	SDL_atomic_t tail;
+	SDL_sem *ready;
+	SDL_atomic_t running;
+	SDL_Thread *thread;
+	Uint8 *scratch;
+	Uint32 *resized;
+	int acquired;
+	int frames_written;
+	int frames_dropped;
+	Uint64 overhead_ticks;
+} Capture;
+
+int capture_start(Capture *capture, const char *path, int width, int height);
+void capture_acquire(Capture *capture, Framebuffer *fb);
+void capture_submit(Capture *capture, Framebuffer *fb);
+void capture_stop(Capture *capture);
+int capture_open(Capture *capture, const char *path, int width, int height);
+int capture_write_frame(Capture *capture, const Uint32 *pixels,
+	int width, int height);
+
+#endif /* CAPTURE_H */
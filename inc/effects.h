@@ -0,0 +1,106 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <SDL2/SDL.h>
+#include "maze.h"
+#include "weapon_sprites.h"
+#include "audio.h"
+
+#define PARTICLES_MAX 131072  /* Capacity of the game's particle system */
+#define PARTICLE_GRAVITY 3.0f /* Fall acceleration, heights per second^2 */
+#define PARTICLE_SIZE 0.02f   /* Side of a particle, in cells */
+#define PARTICLE_FADE 4.0f    /* 1 / seconds a particle fades out over */
+
+/**
+ * struct Particles - Fixed-capacity particle system, structure of arrays
+ * @x: Per particle, X in the maze
+ * @y: Per particle, Y in the maze
+ * @z: Per particle, height; 0 is the floor and 1 the ceiling
+ * @vx: Per particle, X speed in cells per second
+ * @vy: Per particle, Y speed in cells per second
+ * @vz: Per particle, height speed per second
+ * @life: Per particle, seconds left to live
+ * @color: Per particle, ARGB8888 color added to what is behind it
+ * @count: Live particles; they are always the first @count entries
+ * @capacity: Room in every array; bursts beyond it are cut short
+ * @version: Bumped whenever live particles change, for the frame keys
+ * @rng: Generator of its own, so effects never disturb the game
+ * @block: Single allocation every array lives in
+ *
+ * Each field is its own contiguous array, so the per-frame integration
+ * is a few straight loops over floats the compiler can vectorize, and
+ * culling keeps the live particles packed at the front.
+ */
+typedef struct Particles
+{
+	float *x;
+	float *y;
+	float *z;
+	float *vx;
+	float *vy;
+	float *vz;
+	float *life;
+	Uint32 *color;
+	int count;
+	int capacity;
+	Uint32 version;
+	Rng rng;
+	void *block;
+} Particles;
+
+/**
+ * struct Burst - Particles thrown out from one point
+ * @x: X of the point
+ * @y: Y of the point
+ * @z: Height of the point
+ * @vx: X speed every particle starts with on top of its own
+ * @vy: Y speed every particle starts with on top of its own
+ * @speed: Largest speed of a particle in a random direction
+ * @life: Longest life of a particle, in seconds
+ * @color: ARGB8888 color
+ * @count: Number of particles
+ */
+typedef struct Burst
+{
+	float x;
+	float y;
+	float z;
+	float vx;
+	float vy;
+	float speed;
+	float life;
+	Uint32 color;
+	int count;
+} Burst;
+
+/**
+ * struct Cues - What the game last looked like to the sound and particle
+ * cues
+ * @tick: Tick the fields below were taken at
+ * @last_shot_time: Player's last shot
+ * @alive: Per enemy, whether it was alive
+ * @health: Per enemy, its health
+ * @last_attack: Per enemy, its last attack
+ * @active: Per bullet, whether it was in flight
+ */
+typedef struct Cues
+{
+	Uint32 tick;
+	Uint32 last_shot_time;
+	int alive[MAX_ENEMIES];
+	float health[MAX_ENEMIES];
+	Uint32 last_attack[MAX_ENEMIES];
+	int active[MAX_BULLETS];
+} Cues;
+
+int particles_init(Particles *particles, int capacity);
+void particles_free(Particles *particles);
+void particles_emit(Particles *particles, const Burst *burst);
+int particles_update(Particles *particles, float seconds);
+int particles_draw(const Particles *particles, Framebuffer *fb,
+	const View *view, const Player *player);
+int run_particle_bench(int count);
+void play_cues(Cues *cues, Uint32 tick, const WeaponSystem *weapon_system,
+	const Player *player, Audio *audio, Particles *particles);
+
+#endif /* EFFECTS_H */
@@ -0,0 +1,76 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "maze.h"
+#include "lightmap.h"
+
+#define FIX_SHIFT 16             /* Fraction bits of a Fixed */
+#define FIX_ONE (1 << FIX_SHIFT) /* 1.0 as a Fixed */
+#define FIX_FAR (1 << 28)        /* Stands in for an infinite distance */
+#define FIX_TRIG_SHIFT 30        /* Fraction bits of the cosine table */
+#define FIX_TURN_BITS 13         /* Trig table entries per turn, as bits */
+#define FIX_TURN (1 << FIX_TURN_BITS)
+#define FIX_LIGHT_SHIFT 10       /* Light table steps are 1/64 of a cell */
+#define FIX_LIGHT_STEPS 4096     /* Light table covers 64 cells */
+
+/* A binary angle is a Uint32 where 2^32 is one whole turn */
+#define FIX_ANGLE_SCALE 683565275.576f /* 2^32 / (2 * pi) */
+#define FIX_FROM_FLOAT(f) ((Fixed)((f) * FIX_ONE))
+#define FIX_TO_FLOAT(f) ((f) * (1.0f / FIX_ONE))
+#define FIX_MUL(a, b) ((Fixed)(((Sint64)(a) * (b)) >> FIX_SHIFT))
+/* A Fixed times a 2.30 cosine */
+#define FIX_MUL_TRIG(a, trig) \
+	((Fixed)(((Sint64)(a) * (trig)) >> FIX_TRIG_SHIFT))
+#define FIX_QUARTER (1u << 30) /* A quarter turn as a binary angle */
+
+/* A 16.16 fixed-point number */
+typedef Sint32 Fixed;
+
+/**
+ * struct FixedTables - Tables that stand in for trig, division and
+ * light_level() in the fixed-point renderer
+ * @cos: Cosine of each of FIX_TURN angles in 2.30 fixed point, so rays
+ * many cells long still land on the same texels; the sine is the cosine
+ * a quarter turn earlier
+ * @inv_cos: |1 / cosine| of each angle, at most FIX_FAR
+ * @light: Light level at each 1/64 cell of distance
+ * @ready: 1 once built
+ */
+typedef struct FixedTables
+{
+	Sint32 cos[FIX_TURN];
+	Fixed inv_cos[FIX_TURN];
+	Uint8 light[FIX_LIGHT_STEPS];
+	int ready;
+} FixedTables;
+
+/**
+ * struct FixedHit - WallHit of the fixed-point renderer
+ * @distance: Distance along the ray
+ * @tex_x: Horizontal texture coordinate, 0 to FIX_ONE
+ * @type: CELL_* value of the cell that was hit
+ * @side: 0 if an X boundary (east/west face) was crossed, 1 for Y
+ * @front_x: Column of the open cell in front of the face
+ * @front_y: Row of the open cell in front of the face
+ */
+typedef struct FixedHit
+{
+	Fixed distance;
+	Fixed tex_x;
+	int type;
+	int side;
+	int front_x;
+	int front_y;
+} FixedHit;
+
+extern FixedTables fixed_tables;
+
+void fixed_tables_init(void);
+Sint32 fixed_lookup(const Sint32 *table, Uint32 angle);
+int fixed_light(const Lightmap *lightmap, Fixed x, Fixed y);
+int trace_ray_fixed(const int maze[15][15], const Fixed *origin,
+	Uint32 angle, Fixed max_depth, FixedHit *hits);
+void cast_rays_fixed(Framebuffer *fb, const View *view, const Player *player,
+	const int maze[15][15], Textures *textures, const Lightmap *lightmap);
+
+#endif /* FIXED_H */
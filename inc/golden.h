@@ -0,0 +1,51 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include "maze.h"
+
+#define GOLDEN_RUNS 20              /* Renders per scene; the best is timed */
+#define GOLDEN_CHANNEL_TOLERANCE 24 /* Max per-channel difference of a match */
+#define GOLDEN_PIXEL_TOLERANCE 0.5  /* Percent of pixels allowed to differ */
+
+/**
+ * struct GoldenScene - Fixed camera pose rendered by the regression check
+ * @name: Scene name, also the golden image file name
+ * @x: Camera X position in the maze
+ * @y: Camera Y position in the maze
+ * @angle: Camera angle in radians
+ * @budget_ms: Maximum best-of-GOLDEN_RUNS time to render the scene
+ */
+typedef struct GoldenScene
+{
+	const char *name;
+	float x;
+	float y;
+	float angle;
+	double budget_ms;
+} GoldenScene;
+
+/**
+ * struct GoldenRig - Headless renderer the scenes are drawn with
+ * @fb: Framebuffer to render into, in the layout picked for the run
+ * @textures: Loaded textures
+ * @view: Default projection, cast on the calling thread, with the
+ * renderer picked for the run
+ * @lightmap: Baked level lighting, without dynamic lights
+ */
+typedef struct GoldenRig
+{
+	Framebuffer fb;
+	Textures textures;
+	View view;
+	Lightmap lightmap;
+} GoldenRig;
+
+int run_golden(const char *dir, int write, double budget_scale, int fixed,
+	int transposed);
+int run_engine_bench(const char *dir);
+int golden_compare(const Framebuffer *fb, const char *path, double *diff);
+int golden_save(const Framebuffer *fb, const char *path);
+int golden_rig_init(GoldenRig *rig, int fixed, int transposed);
+void golden_rig_cleanup(GoldenRig *rig);
+
+#endif /* GOLDEN_H */
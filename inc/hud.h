@@ -0,0 +1,66 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SDL2/SDL.h>
+#include "text.h"
+#include "weapon_sprites.h"
+
+#define STATS_WINDOW_MS 1000 /* Frame statistics are shown per second */
+#define LATENCY_BUCKET_MS 2  /* Width of one latency histogram bucket */
+#define LATENCY_BUCKETS 32   /* The last bucket also holds anything slower */
+
+/**
+ * struct LatencyHistogram - Input-to-present latency of the whole run
+ * @pending: 1 while an input event waits for a frame that shows it
+ * @since: SDL timestamp of the oldest such event
+ * @counts: Samples per LATENCY_BUCKET_MS wide bucket
+ * @samples: Total samples
+ * @worst: Slowest sample in ms
+ */
+typedef struct LatencyHistogram
+{
+	int pending;
+	Uint32 since;
+	Uint32 counts[LATENCY_BUCKETS];
+	Uint32 samples;
+	Uint32 worst;
+} LatencyHistogram;
+
+/**
+ * struct FrameStats - Frame rate and render time shown on the HUD
+ * @window_start: SDL_GetTicks() time the current window began
+ * @window_frames: Frames run so far in the current window
+ * @window_ms: Render time summed over the current window
+ * @window_worst: Longest render time in the current window
+ * @fps: Frames run in the last complete window, per second
+ * @average_ms: Average render time of the last complete window
+ * @worst_ms: Longest render time of the last complete window
+ * @latency: Input-to-present latency histogram
+ * @latency_ms: 95th percentile latency as of the last complete window
+ *
+ * The shown values only change once per window, so they cost at most
+ * one extra HUD redraw per second while nothing else moves.
+ */
+typedef struct FrameStats
+{
+	Uint32 window_start;
+	int window_frames;
+	double window_ms;
+	double window_worst;
+	int fps;
+	float average_ms;
+	float worst_ms;
+	LatencyHistogram latency;
+	int latency_ms;
+} FrameStats;
+
+void latency_input(LatencyHistogram *latency, Uint32 timestamp);
+void latency_frame(LatencyHistogram *latency, int ticks, int drawn,
+	Uint32 now);
+int latency_percentile(const LatencyHistogram *latency, int percent);
+void latency_report(const LatencyHistogram *latency);
+void frame_stats_add(FrameStats *stats, double ms, Uint32 now);
+void draw_hud(SDL_Renderer *renderer, TextBatch *text,
+	const WeaponSystem *weapon_system, const FrameStats *stats);
+
+#endif /* HUD_H */
@@ -0,0 +1,91 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SDL2/SDL.h>
+#include "rng.h"
+
+/* Buttons sampled once per simulation tick */
+#define INPUT_FORWARD 0x01
+#define INPUT_BACK 0x02
+#define INPUT_STRAFE_LEFT 0x04
+#define INPUT_STRAFE_RIGHT 0x08
+#define INPUT_TURN_LEFT 0x10
+#define INPUT_TURN_RIGHT 0x20
+#define INPUT_FIRE 0x40
+#define INPUT_MOVING (INPUT_FORWARD | INPUT_BACK | \
+	INPUT_STRAFE_LEFT | INPUT_STRAFE_RIGHT)
+
+/**
+ * struct Input - Player input for one simulation tick
+ * @buttons: Bitmask of INPUT_* flags held during the tick
+ *
+ * The simulation only ever reads this struct, never the live keyboard,
+ * so a recorded stream of them reproduces a session exactly.
+ */
+typedef struct Input
+{
+	Uint8 buttons;
+} Input;
+
+#define INPUT_QUEUE_SIZE 256 /* Queued key events; a power of two */
+
+/**
+ * struct InputEvent - A game key going down or up
+ * @timestamp: SDL timestamp of the event
+ * @button: INPUT_* flag of the key
+ * @down: 1 for a press, 0 for a release
+ */
+typedef struct InputEvent
+{
+	Uint32 timestamp;
+	Uint8 button;
+	Uint8 down;
+} InputEvent;
+
+/**
+ * struct InputQueue - Key events collected as SDL receives them
+ * @events: Ring buffer of events
+ * @head: Events pushed so far; only the event watch writes it
+ * @tail: Events consumed so far; only the simulation writes it
+ * @overflow: Set by the event watch when the ring was full
+ * @held: Buttons held after the last consumed event
+ *
+ * An SDL event watch pushes every game key event with its timestamp, and
+ * each simulation tick consumes the events that happened before it. One
+ * producer and one consumer with atomic indices need no lock, whichever
+ * thread SDL runs the watch on.
+ */
+typedef struct InputQueue
+{
+	InputEvent events[INPUT_QUEUE_SIZE];
+	SDL_atomic_t head;
+	SDL_atomic_t tail;
+	SDL_atomic_t overflow;
+	Uint8 held;
+} InputQueue;
+
+/* Buttons the bot holds; fire is pressed on its own schedule */
+#define BOT_MOVES (INPUT_MOVING | INPUT_TURN_LEFT | INPUT_TURN_RIGHT)
+
+/**
+ * struct Bot - Player that wanders and shoots at random
+ * @rng: Generator of its own, so it never disturbs the game RNG
+ * @held: Movement and turn buttons being held
+ * @hold: Ticks left before the bot picks new buttons
+ */
+typedef struct Bot
+{
+	Rng rng;
+	Uint8 held;
+	int hold;
+} Bot;
+
+Uint8 input_button(SDL_Scancode scancode);
+void input_from_keyboard(Input *input, const Uint8 *keyboard);
+void input_queue_start(InputQueue *queue);
+void input_queue_stop(InputQueue *queue);
+void input_queue_tick(InputQueue *queue, Input *input, Uint32 until);
+void bot_init(Bot *bot, Uint32 seed);
+void bot_input(Bot *bot, Input *input);
+
+#endif /* INPUT_H */
@@ -0,0 +1,57 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <SDL2/SDL.h>
+
+#define JOBS_MAX_THREADS 32
+
+/**
+ * JobFunc - Processes the items [begin, end) of a parallel loop
+ * @context: Caller data shared by all chunks
+ * @begin: First item
+ * @end: One past the last item
+ */
+typedef void (*JobFunc)(void *context, int begin, int end);
+
+/**
+ * struct JobPool - Persistent worker threads running parallel loops
+ * @threads: Threads taking part in a loop, including the caller
+ * @workers: Worker threads (threads - 1 of them)
+ * @lock: Protects the fields below it
+ * @wake: Signalled when a new loop is started or the pool shuts down
+ * @done: Signalled when the last worker finishes a loop
+ * @func: Loop body of the current loop
+ * @context: Loop data of the current loop
+ * @count: Items in the current loop
+ * @chunk: Items handed out per grab
+ * @next: Next item to hand out
+ * @busy: Workers still running the current loop
+ * @generation: Incremented for every loop, so workers see each one once
+ * @quit: Set when the pool shuts down
+ *
+ * The caller works on the loop too, so a pool with one thread simply runs
+ * the loop inline with no locking.
+ */
+typedef struct JobPool
+{
+	int threads;
+	SDL_Thread *workers[JOBS_MAX_THREADS];
+	SDL_mutex *lock;
+	SDL_cond *wake;
+	SDL_cond *done;
+	JobFunc func;
+	void *context;
+	int count;
+	int chunk;
+	SDL_atomic_t next;
+	int busy;
+	int generation;
+	int quit;
+} JobPool;
+
+int job_pool_init(JobPool *pool, int threads);
+void job_pool_run(JobPool *pool, JobFunc func, void *context, int count,
+	int chunk);
+void job_pool_destroy(JobPool *pool);
+
+#endif /* JOBS_H */
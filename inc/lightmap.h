@@ -0,0 +1,63 @@
+#ifndef LIGHTMAP_H
+#define LIGHTMAP_H
+
+#include <SDL2/SDL.h>
+
+#define LIGHTMAP_SIZE 15      /* Cells per side, matches the maze */
+#define MAX_LIGHTS 20         /* Dynamic lights; one per bullet slot */
+#define LIGHT_AMBIENT -6      /* Light level offset of unlit cells */
+#define TORCH_RADIUS 4.0f     /* Reach of a torch in cells */
+#define TORCH_STRENGTH 12     /* Light levels a torch adds at its center */
+#define MUZZLE_RADIUS 3.0f    /* Reach of a muzzle flash in cells */
+#define MUZZLE_STRENGTH 16    /* Light levels a muzzle flash adds */
+#define MUZZLE_FLASH_MS 120   /* How long a shot keeps lighting its bullet */
+
+/**
+ * struct Light - Point light lighting every cell it can see in its radius
+ * @x: X position in the maze
+ * @y: Y position in the maze
+ * @radius: Distance in cells at which the light fades out
+ * @strength: Light levels added at the light's own position
+ * @expires: Simulation time the light goes out
+ * @active: 1 while the light is applied to the lightmap
+ */
+typedef struct Light
+{
+	float x;
+	float y;
+	float radius;
+	int strength;
+	Uint32 expires;
+	int active;
+} Light;
+
+/**
+ * struct Lightmap - Per-cell light level offsets
+ * @baked: Ambient and static torch light, computed once at load
+ * @dynamic: Sum of the active dynamic lights' contributions
+ * @level: baked + dynamic, clamped; what the renderer samples
+ * @lights: Dynamic lights, indexed by the owner's slot
+ * @version: Bumped on every change, so renderers can tell it changed
+ *
+ * Offsets are added to the distance light level of walls, floor and
+ * sprites. A dynamic light only touches the cells within its radius when
+ * it is placed, moved or removed, so sampling stays a single load.
+ */
+typedef struct Lightmap
+{
+	Sint16 baked[LIGHTMAP_SIZE][LIGHTMAP_SIZE];
+	Sint16 dynamic[LIGHTMAP_SIZE][LIGHTMAP_SIZE];
+	Sint8 level[LIGHTMAP_SIZE][LIGHTMAP_SIZE];
+	Light lights[MAX_LIGHTS];
+	Uint32 version;
+} Lightmap;
+
+void lightmap_bake(Lightmap *lightmap, const int maze[15][15]);
+void lightmap_apply(Lightmap *lightmap, const Light *light, int sign);
+int lightmap_sample(const Lightmap *lightmap, float x, float y);
+void lightmap_place(Lightmap *lightmap, int id, float x, float y,
+	Uint32 expires);
+void lightmap_remove(Lightmap *lightmap, int id);
+void lightmap_expire(Lightmap *lightmap, Uint32 time);
+
+#endif /* LIGHTMAP_H */
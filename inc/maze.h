@@ -8,7 +8,11 @@
 #include <stdio.h>
 #include <time.h>
 #include "player.h"
+#include "rng.h"
+#include "replay.h"
+#include "jobs.h"
 #include "weapon_sprites.h"
+#include "hud.h"
 
 #define SCREEN_WIDTH 700
 #define SCREEN_HEIGHT 600
@@ -16,12 +20,56 @@
 #define MAZE_ROWS 15
 #define MAZE_COLS 15
 #define TEXTURE_SIZE 64  /* Size of wall and floor textures */
+#define TICK_MS 16       /* Simulation step in milliseconds */
+/* Step in milliseconds nearest to @rate ticks per second */
+#define TICK_MS_AT(rate) ((1000 + (rate) / 2) / (rate))
 
-/* Constants for raycasting */
+/* Maze cell values */
+#define CELL_EMPTY 0
+#define CELL_WALL 1       /* Solid full-height wall */
+#define CELL_GRATE 2      /* See-through grate; blocks movement */
+#define CELL_DOOR 3       /* Sliding door; passable once open */
+#define CELL_LOW_WALL 4   /* Half-height wall that can be seen over */
+#define LOW_WALL_HEIGHT 0.5f
+#define CELL_HEIGHT(type) ((type) == CELL_LOW_WALL ? LOW_WALL_HEIGHT : 1.0f)
+
+/* Doors open while the player is near and are passable once nearly open */
+#define DOOR_OPEN 255       /* door_open value of a fully open door */
+#define DOOR_PASSABLE 230   /* Open amount from which the door can be passed */
+#define DOOR_RANGE 1.8f     /* Distance from the door center that opens it */
+#define DOOR_SPEED 8        /* Open amount change per TICK_MS */
+
+/* sweep_walls()/sweep_circle() result when the segment hits nothing */
+#define SWEEP_CLEAR 2.0f
+/* Most cells a segment inside the maze passes through */
+#define SWEEP_CELLS (MAZE_COLS + MAZE_ROWS - 1)
+
+/* Raycasting defaults (one ray is cast per render column) */
+#define MAX_WALL_HITS 4 /* Layers (grates, doors, low walls) kept per column */
 #define FOV 60.0       /* Field of View in degrees */
-#define NUM_RAYS 640   /* Number of rays to cast */
 #define MAX_DEPTH 10   /* Maximum distance a ray can travel */
 
+/* Distance shading, quantized into pre-shaded texture copies */
+#define LIGHT_LEVELS 48      /* Light levels per texture, darkest first */
+#define LIGHT_FULL 31        /* Level of an unlit surface at point blank */
+#define LIGHT_MIN 0.3f       /* Brightness of the darkest level */
+#define LIGHT_FALLOFF 0.1f   /* Brightness lost per cell of distance */
+#define FOG_COLOR 0x000000u  /* Default color distant surfaces fade into */
+#define TEXELS (TEXTURE_SIZE * TEXTURE_SIZE)
+#define LIGHT_STEP ((1.0f - LIGHT_MIN) / LIGHT_FULL) /* Brightness per level */
+#define LIGHT_CLAMP(level) ((level) < 0 ? 0 : (level) >= LIGHT_LEVELS ? \
+	LIGHT_LEVELS - 1 : (level))
+
+/* Packs an opaque ARGB8888 framebuffer pixel */
+#define FB_RGB(r, g, b) (0xFF000000u | ((Uint32)(r) << 16) | \
+	((Uint32)(g) << 8) | (Uint32)(b))
+
+/* Start of column x of the buffer the 3D view is cast into, and the
+ * distance between its rows: contiguous columns while transposed */
+#define FB_COLUMN(fb, x) ((fb)->transposed ? (fb)->columns + \
+	(size_t)(x) * (fb)->column_pitch : (fb)->pixels + (x))
+#define FB_ROW_STEP(fb) ((fb)->transposed ? 1 : (fb)->pitch)
+
 
 /**
  * struct Textures - Stores texture data for different surfaces.
@@ -30,6 +78,15 @@
  * @floor: Pointer to pixel data for the floor texture.
  * @width: The width of the texture.
  * @height: The height of the texture.
+ * @grate: Pixel data for grates; texels with zero alpha are holes
+ * @ns_shades: north_south pre-shaded at each of the LIGHT_LEVELS
+ * @ew_shades: east_west pre-shaded at each light level
+ * @floor_shades: floor pre-shaded at each light level
+ * @ceiling_shades: floor at half brightness, pre-shaded at each level
+ * @grate_shades: grate pre-shaded at each level, holes kept at 0
+ *
+ * Each shade table holds LIGHT_LEVELS consecutive TEXELS-sized copies
+ * blended towards the fog color, so shading a pixel is a single load.
  */
 struct Textures
 {
@@ -38,40 +95,198 @@ struct Textures
 	Uint32 *floor;
 	int width;
 	int height;
+	Uint32 *grate;
+	Uint32 *ns_shades;
+	Uint32 *ew_shades;
+	Uint32 *floor_shades;
+	Uint32 *ceiling_shades;
+	Uint32 *grate_shades;
 };
 typedef struct Textures Textures;
+
+/**
+ * struct Framebuffer - CPU pixel buffer the 3D view is rendered into
+ * @pixels: ARGB8888 pixels being rendered this frame (backing or a
+ * capture slot)
+ * @backing: Pixel buffer owned by the framebuffer
+ * @depth: Per column, distance to the opaque wall the ray stopped at
+ * @columns: Column-major scratch the 3D view is cast into while
+ * transposed
+ * @width: Current render width in pixels
+ * @height: Current render height in pixels
+ * @pitch: Distance between rows, in pixels
+ * @column_pitch: Distance between columns of @columns, in pixels
+ * @transposed: 1 to cast into @columns and transpose it into @pixels
+ * @max_width: Allocated width; the render size never exceeds it
+ * @max_height: Allocated height
+ * @texture: Streaming texture the pixels are uploaded to for presenting
+ * @valid: 1 while pixels and texture still hold the frame for the keys
+ * @world_key: Hash of everything the 3D view was rendered from
+ * @frame_key: Hash of world_key plus everything drawn over it
+ *
+ * The render size is decoupled from the window: frames are rendered into
+ * the top-left width x height pixels and stretched over the window.
+ * Rays fill one column at a time, which in @pixels strides a whole row
+ * per pixel; while transposed they fill @columns contiguously instead
+ * and resolve_framebuffer() turns it into rows once per frame.
+ */
+struct Framebuffer
+{
+	Uint32 *pixels;
+	Uint32 *backing;
+	float *depth;
+	Uint32 *columns;
+	int width;
+	int height;
+	int pitch;
+	int column_pitch;
+	int transposed;
+	int max_width;
+	int max_height;
+	SDL_Texture *texture;
+	int valid;
+	Uint32 world_key;
+	Uint32 frame_key;
+};
+typedef struct Framebuffer Framebuffer;
+
+/**
+ * struct View - Projection settings and per-column ray tables
+ * @fov: Horizontal field of view in radians
+ * @max_depth: Maximum distance a ray travels, in cells
+ * @columns: Render width the tables were last built for
+ * @capacity: Columns the tables have room for
+ * @ray_angle: Angle of each column's ray relative to the view direction
+ * @ray_turn: ray_angle as binary angles, for the fixed-point renderer
+ * @rows: Render height the row tables were built for
+ * @row_capacity: Allocated length of the row tables
+ * @row_distance: Floor distance seen through each row below the horizon
+ * @row_light: Light level of the floor and ceiling at each row
+ * @row_fixed: row_distance in 16.16 fixed point
+ * @jobs: Render threads, or NULL to render on the calling thread
+ * @fixed: 1 to render with the 16.16 fixed-point renderer
+ */
+struct View
+{
+	float fov;
+	float max_depth;
+	int columns;
+	int capacity;
+	float *ray_angle;
+	Uint32 *ray_turn;
+	int rows;
+	int row_capacity;
+	float *row_distance;
+	Uint8 *row_light;
+	Sint32 *row_fixed;
+	JobPool *jobs;
+	int fixed;
+};
+typedef struct View View;
+
+/**
+ * struct WallHit - One surface a ray crossed, nearest first
+ * @distance: Distance along the ray
+ * @tex_x: Horizontal texture coordinate, 0 to 1
+ * @type: CELL_* value of the cell that was hit
+ * @side: 0 if an X boundary (east/west face) was crossed, 1 for Y
+ * @front_x: Column of the open cell in front of the face
+ * @front_y: Row of the open cell in front of the face
+ */
+struct WallHit
+{
+	float distance;
+	float tex_x;
+	int type;
+	int side;
+	int front_x;
+	int front_y;
+};
+typedef struct WallHit WallHit;
+
 extern const int maze[MAZE_ROWS][MAZE_COLS];
+extern Uint8 door_open[MAZE_ROWS][MAZE_COLS];
 /* extern Textures textures;  Global textures */
 
-int init_sdl(SDL_Window **window, SDL_Renderer **renderer);
-int init_textures(Textures *textures);
+int init_sdl(SDL_Window **window, SDL_Renderer **renderer,
+	int width, int height, int vsync);
+int init_textures(Textures *textures, Uint32 fog);
+int shade_textures(Textures *textures, Uint32 fog);
+int light_level(float distance);
 void cleanup_textures(Textures *textures);
+int init_framebuffer(Framebuffer *fb, SDL_Renderer *renderer,
+	int width, int height);
+int framebuffer_resize(Framebuffer *fb, SDL_Renderer *renderer,
+	int width, int height);
+void framebuffer_set_size(Framebuffer *fb, int width, int height);
+void clear_framebuffer(Framebuffer *fb);
+void resolve_framebuffer(Framebuffer *fb);
+void upload_framebuffer(Framebuffer *fb);
+void present_framebuffer(SDL_Renderer *renderer, Framebuffer *fb);
+void cleanup_framebuffer(Framebuffer *fb);
 /**
  * struct GameState - Holds the current state of the game.
  * @show_minimap: Flag to determine if the minimap should be displayed
+ * @minimap_span: Cells across the minimap (zoom); 0 shows the whole maze
+ * @rng: Random number generator all simulation randomness is drawn from
+ * @tick: Number of simulation ticks run so far
+ * @input: Input applied on the most recent tick
  *
  * This struct stores global game state variables, such as UI toggles.
  */
 struct GameState
 {
 	int show_minimap;
+	int minimap_span;
+	Rng rng;
+	Uint32 tick;
+	Input input;
 };
 typedef struct GameState GameState;
 
 extern GameState game_state;
 
-void render_frame(SDL_Renderer *renderer, Player *player,
-	Textures *textures, GameState *game_state, WeaponSystem *weapon_system);
-void handle_events(int *running, GameState *game_state);
-void cast_rays(SDL_Renderer *renderer, Player *player, const int maze[15][15],
-	Textures *textures);
-void draw_textured_wall(SDL_Renderer *renderer, int x, int wall_height,
-	float tex_x, float distance, int is_ns, Textures *textures);
-void draw_floor(SDL_Renderer *renderer, int x, int wall_height,
-		const Player *player, float ray_angle, Textures *textures);
-void draw_minimap(SDL_Renderer *renderer, const Player *player, GameState
-	*game_state, WeaponSystem *weapon_system);
+/* What render_frame() had to do (see session.h) */
+#define FRAME_SKIPPED 0  /* Nothing changed; the last frame stays up */
+#define FRAME_OVERLAY 1  /* Only sprites or HUD changed; 3D view reused */
+#define FRAME_FULL 2     /* The 3D view was cast again */
+
+void game_init(GameState *game_state, Player *player,
+	WeaponSystem *weapon_system, Uint32 seed);
+int step_game(GameState *game_state, Player *player,
+	WeaponSystem *weapon_system, Replay *replay, const Input *live);
+Uint32 hash_bytes(Uint32 hash, const void *data, size_t size);
+Uint32 world_key(const Framebuffer *fb, const View *view,
+	const Player *player, const Lightmap *lightmap);
+Uint32 frame_key(SDL_Renderer *renderer, Uint32 world,
+	const GameState *game_state, const WeaponSystem *weapon_system,
+	const FrameStats *stats);
+Uint32 game_state_hash(const GameState *game_state, const Player *player,
+	const WeaponSystem *weapon_system);
+void view_init(View *view, float fov, float max_depth, JobPool *jobs);
+int view_update(View *view, int columns, int rows);
+void view_cleanup(View *view);
+void cast_rays(Framebuffer *fb, View *view, Player *player,
+	const int maze[15][15], Textures *textures, const Lightmap *lightmap);
+int trace_ray(const int maze[15][15], const Player *player, float angle,
+	float max_depth, WallHit *hits);
+void draw_textured_wall(Framebuffer *fb, int x, int wall_height,
+	const WallHit *hit, int level, Textures *textures);
+void doors_reset(void);
+void doors_update(const Player *player, Uint32 tick_ms);
+int cell_blocks(const int maze[15][15], int x, int y);
+float sweep_walls(const int maze[15][15], float x0, float y0,
+	float x1, float y1);
+float sweep_circle(float x0, float y0, float x1, float y1,
+	float cx, float cy, float radius);
+int sweep_cells(float x0, float y0, float x1, float y1, int *cells);
+void draw_floor(Framebuffer *fb, const View *view, int x, int wall_height,
+		const Player *player, float ray_angle, Textures *textures,
+		const Lightmap *lightmap);
+void draw_minimap(SDL_Renderer *renderer, Minimap *minimap,
+	const Player *player, GameState *game_state, WeaponSystem *weapon_system);
 void toggle_minimap(GameState *game_state);
+void minimap_key(GameState *game_state, SDL_Keycode key);
 void cleanup(SDL_Window *window, SDL_Renderer *renderer);
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <SDL2/SDL.h>
+
+#define MINIMAP_SIZE 100     /* Largest on-screen side in pixels */
+#define MINIMAP_MARGIN 10    /* Gap to the top right corner of the window */
+#define MINIMAP_CELL_PX 12   /* Texels per cell in the cached wall layer */
+#define MINIMAP_SPAN_MIN 5   /* Cells across the minimap when fully zoomed in */
+
+/**
+ * struct Minimap - Cached static layer of the minimap
+ * @layer: Render target holding every cell of the maze, or NULL
+ * @valid: 0 when the layer must be drawn again (map load, lost targets)
+ *
+ * The walls are drawn into @layer once; each frame only copies the part
+ * around the player and draws the moving markers on top.
+ */
+typedef struct Minimap
+{
+	SDL_Texture *layer;
+	int valid;
+} Minimap;
+
+/**
+ * struct MinimapView - Where the visible part of the maze lands on screen
+ * @rect: On-screen rectangle of the minimap
+ * @left: Maze X coordinate shown at the left edge of @rect
+ * @top: Maze Y coordinate shown at the top edge of @rect
+ * @scale: Pixels per cell
+ */
+typedef struct MinimapView
+{
+	SDL_Rect rect;
+	float left;
+	float top;
+	int scale;
+} MinimapView;
+
+/* Screen position of a maze coordinate on the minimap */
+#define MINIMAP_X(view, mx) \
+	((view)->rect.x + ((mx) - (view)->left) * (view)->scale)
+#define MINIMAP_Y(view, my) \
+	((view)->rect.y + ((my) - (view)->top) * (view)->scale)
+
+void minimap_cleanup(Minimap *minimap);
+
+#endif /* MINIMAP_H */
@@ -0,0 +1,218 @@
+#ifndef NET_H
+#define NET_H
+
+#include <SDL2/SDL.h>
+#include <netinet/in.h>
+#include "maze.h"
+#include "weapon_sprites.h"
+
+#define NET_PORT 27960        /* Default server port */
+#define NET_MAX_CLIENTS 32    /* Clients one server sends snapshots to */
+#define NET_HISTORY 64        /* Snapshots kept as delta bases; power of 2 */
+#define NET_PACKET_MAX 1200   /* Largest datagram, below a typical MTU */
+#define NET_TIMEOUT_MS 2000   /* Clients silent this long are dropped */
+#define NET_INTERP_TICKS 3    /* Clients show the world this many ticks late */
+#define NET_MAX_DOORS 8       /* Door cells a snapshot carries */
+
+/* Snapshot quantization */
+#define NET_POS_BITS 12       /* Positions in 1/256 cell, up to 16 cells */
+#define NET_POS_SCALE 256.0f
+#define NET_ANGLE_BITS 12     /* Player angle in 1/4096 turn */
+#define NET_AGE_BITS 6        /* Ticks since a shot or attack, up to 63 */
+#define NET_AGE_MAX ((1 << NET_AGE_BITS) - 1) /* Sent for "long ago" */
+#define NET_PACKET_SERVER 'S' /* First byte of a snapshot packet */
+#define NET_PACKET_CLIENT 'C' /* First byte of an input and ack packet */
+
+/**
+ * struct Bits - Bit-level reader or writer over a packet buffer
+ * @data: Packet bytes
+ * @size: Size of @data in bytes
+ * @pos: Bits written or read so far
+ * @writing: 1 when writing, 0 when reading
+ * @overflow: Set once a read or write ran past @size
+ *
+ * Values are stored most significant bit first with no alignment, so a
+ * 12-bit field takes 12 bits.
+ */
+typedef struct Bits
+{
+	Uint8 *data;
+	int size;
+	int pos;
+	int writing;
+	int overflow;
+} Bits;
+
+/* Bytes used by everything written so far */
+#define BITS_BYTES(bits) (((bits)->pos + 7) / 8)
+
+/**
+ * struct NetEnemy - Quantized enemy state in a snapshot
+ * @x: X position in 1/NET_POS_SCALE cells
+ * @y: Y position in 1/NET_POS_SCALE cells
+ * @alive: 1 if alive
+ * @health: Health points, 0 to 255
+ * @attack_age: Ticks since its last attack, NET_AGE_MAX if longer ago
+ */
+typedef struct NetEnemy
+{
+	Uint16 x;
+	Uint16 y;
+	Uint8 alive;
+	Uint8 health;
+	Uint8 attack_age;
+} NetEnemy;
+
+/**
+ * struct NetBullet - Quantized bullet state in a snapshot
+ * @x: X position in 1/NET_POS_SCALE cells
+ * @y: Y position in 1/NET_POS_SCALE cells
+ * @active: 1 if flying
+ */
+typedef struct NetBullet
+{
+	Uint16 x;
+	Uint16 y;
+	Uint8 active;
+} NetBullet;
+
+/**
+ * struct Snapshot - Everything a client needs to draw one tick
+ * @tick: Simulation tick the snapshot was taken after
+ * @x: Player X in 1/NET_POS_SCALE cells
+ * @y: Player Y in 1/NET_POS_SCALE cells
+ * @angle: Player angle in 1/2^NET_ANGLE_BITS turns
+ * @score: Score
+ * @health: Player health, clamped to 0 to 255
+ * @enemy_count: Living enemies
+ * @shot_age: Ticks since the player's last shot, NET_AGE_MAX if longer ago
+ * @doors: Open amount of each door cell, in maze order
+ * @enemies: Enemies
+ * @bullets: Bullets
+ *
+ * Snapshots are always filled in whole with memcpy()/memset(), so two of
+ * them can be compared with memcmp().
+ */
+typedef struct Snapshot
+{
+	Uint32 tick;
+	Uint16 x;
+	Uint16 y;
+	Uint16 angle;
+	Uint32 score;
+	Uint8 health;
+	Uint8 enemy_count;
+	Uint8 shot_age;
+	Uint8 doors[NET_MAX_DOORS];
+	NetEnemy enemies[MAX_ENEMIES];
+	NetBullet bullets[MAX_BULLETS];
+} Snapshot;
+
+/**
+ * struct NetPeer - A client as the server sees it
+ * @address: Where the client's packets come from
+ * @active: 1 while the slot is in use
+ * @acked: Newest snapshot tick the client confirmed, 0 for none
+ * @heard: Server tick of the client's last packet
+ * @bytes: Snapshot bytes sent to the client
+ * @packets: Snapshots sent to the client
+ * @full: Snapshots that could not be delta-encoded
+ */
+typedef struct NetPeer
+{
+	struct sockaddr_in address;
+	int active;
+	Uint32 acked;
+	Uint32 heard;
+	Uint32 bytes;
+	Uint32 packets;
+	Uint32 full;
+} NetPeer;
+
+/**
+ * struct Server - Authoritative game server
+ * @socket: UDP socket
+ * @port: Port the socket is bound to
+ * @tick_ms: Simulation tick length, sent to clients
+ * @history: Snapshots sent, by tick % NET_HISTORY
+ * @peers: Client slots; the lowest active one controls the player
+ * @held: Buttons the controlling client last reported
+ * @input: Buttons for the next tick, including taps since the last one
+ *
+ * Each client gets every snapshot delta-encoded against the newest one
+ * it acknowledged, or in full if that one has left the history.
+ */
+typedef struct Server
+{
+	int socket;
+	int port;
+	Uint32 tick_ms;
+	Snapshot history[NET_HISTORY];
+	NetPeer peers[NET_MAX_CLIENTS];
+	Uint8 held;
+	Uint8 input;
+} Server;
+
+/**
+ * struct Client - Connection to a server that runs the simulation
+ * @socket: UDP socket
+ * @server: Server address
+ * @history: Snapshots received, by tick % NET_HISTORY
+ * @latest: Newest snapshot tick, 0 before the first arrives
+ * @arrived: SDL_GetTicks() time the newest snapshot arrived
+ * @tick_ms: Server tick length
+ * @bytes: Snapshot bytes received
+ *
+ * The client shows the world NET_INTERP_TICKS behind the newest
+ * snapshot, interpolating between the two snapshots around that time,
+ * so motion stays smooth when packets arrive unevenly.
+ */
+typedef struct Client
+{
+	int socket;
+	struct sockaddr_in server;
+	Snapshot history[NET_HISTORY];
+	Uint32 latest;
+	Uint32 arrived;
+	Uint32 tick_ms;
+	Uint32 bytes;
+} Client;
+
+void bits_init(Bits *bits, Uint8 *data, int size, int writing);
+void bits_write(Bits *bits, Uint32 value, int count);
+Uint32 bits_read(Bits *bits, int count);
+Uint32 bits_field(Bits *bits, Uint32 value, int count);
+
+void snapshot_capture(Snapshot *snapshot, const GameState *game_state,
+	const Player *player, const WeaponSystem *weapon_system);
+void snapshot_apply(const Snapshot *snapshot, Uint32 tick_ms,
+	GameState *game_state, Player *player, WeaponSystem *weapon_system);
+void snapshot_lerp(const Snapshot *a, const Snapshot *b, float t,
+	Player *player, WeaponSystem *weapon_system);
+void snapshot_encode(Bits *bits, const Snapshot *base,
+	const Snapshot *snapshot);
+int snapshot_decode(Bits *bits, const Snapshot *base, Snapshot *snapshot);
+
+int udp_open(int *port);
+int udp_resolve(const char *text, struct sockaddr_in *address);
+void udp_send(int socket, const struct sockaddr_in *to, const Uint8 *data,
+	int size);
+int udp_receive(int socket, struct sockaddr_in *from, Uint8 *data,
+	int size);
+void udp_close(int socket);
+
+int server_start(Server *server, int port, Uint32 tick_ms);
+void server_receive(Server *server, Uint32 tick, Input *input);
+void server_send(Server *server, const Snapshot *snapshot);
+void server_stop(Server *server);
+
+int client_start(Client *client, const char *address);
+int client_receive(Client *client, Uint32 now);
+void client_send(Client *client, const Input *input);
+int client_sample(const Client *client, Uint32 now, GameState *game_state,
+	Player *player, WeaponSystem *weapon_system);
+void client_stop(Client *client);
+
+int run_net_bench(int max_clients, Uint32 seed, Uint32 tick_ms);
+
+#endif /* NET_H */
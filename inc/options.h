@@ -0,0 +1,84 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <SDL2/SDL.h>
+
+#define CONFIG_DEFAULT_PATH "maze.cfg" /* Loaded at startup if present */
+
+/**
+ * struct Options - Settings from the config file and the command line
+ * @capture_path: File to record gameplay video to, or NULL
+ * @record_path: File to record per-tick input to, or NULL
+ * @replay_path: Input recording to play back instead of the keyboard
+ * @seed: Seed for the game RNG (ignored when replaying)
+ * @golden_dir: Run the headless golden-image check against this directory
+ * @golden_write: 1 to rewrite the golden images instead of checking them
+ * @budget_scale: Multiplier for the golden check's frame-time budgets
+ * @bench_engines: Time the float and fixed-point renderers, writing rows
+ * and columns, on the golden scenes in this directory instead of running
+ * the game
+ * @target_ms: Frame time the dynamic resolution holds; 0 disables it
+ * @scale: Initial render scale relative to the full render size
+ * @window_width: Initial window width
+ * @window_height: Initial window height
+ * @fov: Horizontal field of view in degrees
+ * @rays: Rays cast at full render scale; 0 casts one per window column
+ * @max_depth: Maximum distance a ray travels, in cells
+ * @threads: Render threads; 0 uses one per CPU core
+ * @vsync: 1 to synchronize presents with the display refresh
+ * @tick_rate: Simulation ticks per second
+ * @fog: Color distant surfaces fade into, 0xRRGGBB
+ * @latency: 1 to print an input latency histogram on exit
+ * @bench_entities: Run the entity update benchmark with this many
+ * enemies and bullets instead of the game
+ * @bench_particles: Run the particle benchmark with up to this many
+ * particles instead of the game
+ * @connect: Server to watch or play on instead of simulating locally
+ * @load_path: Save to start the game from instead of the seed
+ * @save_path: File to save the game to on exit and when autosaving
+ * @autosave: Seconds between autosaves to save_path; 0 saves on exit only
+ * @volume: Sound volume, 0 to 100; 0 opens no audio device
+ * @fixed: 1 to render with 16.16 fixed-point math instead of floats
+ * @transpose: 1 to cast into a column-major buffer and transpose it
+ *
+ * Every option can be given on the command line as "--name value" or in
+ * the config file as "name = value"; the command line wins.
+ */
+typedef struct Options
+{
+	const char *capture_path;
+	const char *record_path;
+	const char *replay_path;
+	Uint32 seed;
+	const char *golden_dir;
+	int golden_write;
+	double budget_scale;
+	const char *bench_engines;
+	double target_ms;
+	float scale;
+	int window_width;
+	int window_height;
+	float fov;
+	int rays;
+	float max_depth;
+	int threads;
+	int vsync;
+	int tick_rate;
+	Uint32 fog;
+	int latency;
+	int bench_entities;
+	int bench_particles;
+	const char *connect;
+	const char *load_path;
+	const char *save_path;
+	int autosave;
+	int volume;
+	int fixed;
+	int transpose;
+} Options;
+
+int parse_options(int argc, char **argv, Options *options);
+int set_option(Options *options, const char *name, const char *value);
+int load_config(Options *options, const char *path, int required);
+
+#endif /* OPTIONS_H */
@@ -0,0 +1,27 @@
+#ifndef PACER_H
+#define PACER_H
+
+#include <SDL2/SDL.h>
+
+#define PACER_MARGIN_MAX 4       /* Most ms left to the 1 ms sleeps */
+#define PACER_MARGIN_DECAY 0.95f /* How fast a past oversleep is forgotten */
+
+/**
+ * struct FramePacer - Sleeps the main loop until its next deadline
+ * @vsync: 1 if presents already wait for the display refresh
+ * @oversleep_ms: Recent worst amount SDL_Delay() overslept by
+ *
+ * The pacer sleeps until @oversleep_ms before the deadline, then sleeps
+ * 1 ms at a time until the deadline passes. That wakes the loop on time,
+ * so input is sampled fresh, without keeping a core busy.
+ */
+typedef struct FramePacer
+{
+	int vsync;
+	float oversleep_ms;
+} FramePacer;
+
+void pacer_init(FramePacer *pacer, int vsync);
+void pacer_wait(FramePacer *pacer, Uint32 deadline, int presented);
+
+#endif /* PACER_H */
@@ -3,6 +3,8 @@
 
 #include <SDL2/SDL.h>
 #include <math.h>
+#include "input.h"
+#include "minimap.h"
 
 /**
  * struct Player - Structure for player data
@@ -25,12 +27,12 @@ typedef struct Player Player;
 /* Function prototypes */
 void init_player(Player *player, float start_x,
 	float start_y, float start_angle);
-void update_player(Player *player, const Uint8 *keyboard,
-	const int maze[15][15]);
+void update_player(Player *player, const Input *input,
+	const int maze[15][15], float step);
 void move_player(Player *player, const int maze[15][15],
 	float forward, float strafe);
-void draw_minimap_player(SDL_Renderer *renderer, int map_x, int map_y,
-			int cell_size, const Player *player);
+void draw_minimap_player(SDL_Renderer *renderer, const MinimapView *view,
+			const Player *player);
 
 
 #endif /* PLAYER_H */
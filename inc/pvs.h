@@ -0,0 +1,31 @@
+#ifndef PVS_H
+#define PVS_H
+
+#include <SDL2/SDL.h>
+
+#define PVS_SIZE 15                           /* Cells per side of the maze */
+#define PVS_CELLS (PVS_SIZE * PVS_SIZE)
+#define PVS_WORDS ((PVS_CELLS + 31) / 32)     /* 32-bit words per cell's set */
+#define PVS_SAMPLES 3    /* Sample points per cell axis when building */
+
+/**
+ * struct Pvs - Potentially visible set of every maze cell
+ * @bits: One bitset per cell; bit b of cell a is set if some point of
+ * cell b can be seen from some point of cell a
+ *
+ * Only solid walls (value 1) block sight, as in the ray caster, so the
+ * sets are conservative: a cleared bit means the cells can never see
+ * each other and callers may skip any finer visibility test.
+ */
+typedef struct Pvs
+{
+	Uint32 bits[PVS_CELLS][PVS_WORDS];
+} Pvs;
+
+int pvs_segment_clear(const int maze[15][15], float x0, float y0,
+	float x1, float y1);
+void pvs_build(Pvs *pvs, const int maze[15][15]);
+int pvs_visible(const Pvs *pvs, float from_x, float from_y,
+	float to_x, float to_y);
+
+#endif /* PVS_H */
@@ -0,0 +1,84 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include "input.h"
+
+#define REPLAY_MAGIC "MZRP"
+#define REPLAY_VERSION 2
+#define REPLAY_END 0xFF   /* Button byte marking the end-of-stream trailer */
+
+/**
+ * enum ReplayMode - What a Replay does with the per-tick input
+ * @REPLAY_OFF: Live input, nothing recorded
+ * @REPLAY_RECORD: Live input, appended to the file every tick
+ * @REPLAY_PLAY: Input read back from the file instead of the keyboard
+ */
+enum ReplayMode
+{
+	REPLAY_OFF,
+	REPLAY_RECORD,
+	REPLAY_PLAY
+};
+
+/**
+ * struct Replay - Run-length encoded per-tick input stream
+ * @file: Replay file, or NULL when off
+ * @mode: Recording, playing or off
+ * @seed: Seed the game RNG is started from
+ * @tick_ms: Simulation tick length the session runs at
+ * @buttons: Buttons of the current run
+ * @run: Ticks in the current run (recorded, or still to play back)
+ * @ticks: Ticks recorded or played so far
+ * @end_ticks: Tick count stored in the trailer (playback)
+ * @end_hash: Final state hash stored in the trailer (playback)
+ * @ended: 1 once playback has reached the trailer
+ *
+ * File layout: "MZRP", version byte, little-endian u32 seed and tick_ms,
+ * then (buttons, run) byte pairs, then REPLAY_END, 0, u32 ticks, u32 hash.
+ */
+typedef struct Replay
+{
+	FILE *file;
+	enum ReplayMode mode;
+	Uint32 seed;
+	Uint32 tick_ms;
+	Uint8 buttons;
+	Uint8 run;
+	Uint32 ticks;
+	Uint32 end_ticks;
+	Uint32 end_hash;
+	int ended;
+} Replay;
+
+/**
+ * struct ReplayMark - Position within a replay being played or recorded
+ * @offset: File offset of the next (buttons, run) pair
+ * @buttons: Buttons of the current run
+ * @run: Ticks left in (or recorded into) the current run
+ * @ticks: Ticks played or recorded so far
+ *
+ * Seeking back to a mark while recording makes later ticks overwrite
+ * the rest of the file; playback stops at the new trailer.
+ */
+typedef struct ReplayMark
+{
+	long offset;
+	Uint8 buttons;
+	Uint8 run;
+	Uint32 ticks;
+} ReplayMark;
+
+int replay_record_start(Replay *replay, const char *path, Uint32 seed,
+	Uint32 tick_ms);
+int replay_play_start(Replay *replay, const char *path);
+void replay_record(Replay *replay, const Input *input);
+int replay_play(Replay *replay, Input *input);
+int replay_finish(Replay *replay, Uint32 state_hash);
+void replay_write_u32(FILE *file, Uint32 value);
+int replay_read_u32(FILE *file, Uint32 *value);
+void replay_mark(const Replay *replay, ReplayMark *mark);
+int replay_seek(Replay *replay, const ReplayMark *mark);
+
+#endif /* REPLAY_H */
@@ -0,0 +1,34 @@
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include "maze.h"
+
+#define SCALE_MIN 0.4f        /* Lowest render scale the controller picks */
+#define SCALE_STEP_DOWN 0.1f  /* Scale removed when over budget */
+#define SCALE_STEP_UP 0.05f   /* Scale added back when well under budget */
+#define SCALE_COOLDOWN 30     /* Frames to wait after each change */
+
+/**
+ * struct ResolutionScaler - Picks the internal render resolution
+ * @scale: Current fraction of the full framebuffer size, per axis
+ * @target_ms: Frame time to hold; 0 keeps the scale fixed
+ * @average_ms: Exponential moving average of recent frame times
+ * @cooldown: Frames left before the scale may change again
+ *
+ * Drops resolution quickly when frames run over budget and raises it
+ * slowly once there is clear headroom, so it does not oscillate.
+ */
+typedef struct ResolutionScaler
+{
+	float scale;
+	double target_ms;
+	double average_ms;
+	int cooldown;
+} ResolutionScaler;
+
+void resolution_init(ResolutionScaler *scaler, double target_ms, float scale);
+void resolution_update(ResolutionScaler *scaler, Framebuffer *fb,
+	double frame_ms);
+void resolution_apply(const ResolutionScaler *scaler, Framebuffer *fb);
+
+#endif /* RESOLUTION_H */
@@ -0,0 +1,19 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * struct Rng - Seeded xorshift32 generator owned by the game state
+ * @state: Current generator state, never zero
+ */
+typedef struct Rng
+{
+	Uint32 state;
+} Rng;
+
+void rng_seed(Rng *rng, Uint32 seed);
+Uint32 rng_next(Rng *rng);
+float rng_float(Rng *rng);
+
+#endif /* RNG_H */
@@ -0,0 +1,80 @@
+#ifndef SAVE_H
+#define SAVE_H
+
+#include <SDL2/SDL.h>
+#include "maze.h"
+#include "weapon_sprites.h"
+
+#define SAVE_MAGIC "MZSV"
+#define SAVE_VERSION 3
+#define SAVE_MAX 2048       /* Bytes any save takes at most */
+#define REWIND_SLOTS 8      /* Checkpoints a Rewind keeps */
+#define REWIND_SECONDS 5    /* How far back one rewind goes */
+
+/**
+ * struct SaveStream - Byte cursor over a save being written or read
+ * @data: Save bytes
+ * @size: Size of @data
+ * @pos: Bytes written or read so far
+ * @writing: 1 when writing, 0 when reading
+ * @overflow: Set once a field ran past @size
+ *
+ * Fields are stored little-endian whatever the host is, so a save moves
+ * between machines.
+ */
+typedef struct SaveStream
+{
+	Uint8 *data;
+	size_t size;
+	size_t pos;
+	int writing;
+	int overflow;
+} SaveStream;
+
+/**
+ * struct Checkpoint - A save plus where the replay was when it was taken
+ * @data: Save bytes
+ * @size: Bytes used in @data, 0 for an empty slot
+ * @tick: Simulation tick of the save
+ * @mark: Replay position at that tick
+ */
+typedef struct Checkpoint
+{
+	Uint8 data[SAVE_MAX];
+	size_t size;
+	Uint32 tick;
+	ReplayMark mark;
+} Checkpoint;
+
+/**
+ * struct Rewind - Ring of checkpoints taken at a fixed tick interval
+ * @slots: Checkpoints, by (tick / interval) % REWIND_SLOTS
+ * @interval: Ticks between checkpoints
+ *
+ * Taking a checkpoint is a save into memory, a few microseconds, so one
+ * every second costs nothing noticeable. Rewinding restores the newest
+ * checkpoint far enough back; a replay then plays on from there.
+ */
+typedef struct Rewind
+{
+	Checkpoint slots[REWIND_SLOTS];
+	Uint32 interval;
+} Rewind;
+
+size_t save_state(Uint8 *data, size_t size, const GameState *game_state,
+	const Player *player, const WeaponSystem *weapon_system);
+int load_state(const Uint8 *data, size_t size, GameState *game_state,
+	Player *player, WeaponSystem *weapon_system);
+int save_file(const char *path, const GameState *game_state,
+	const Player *player, const WeaponSystem *weapon_system);
+int load_file(const char *path, GameState *game_state, Player *player,
+	WeaponSystem *weapon_system);
+
+void rewind_init(Rewind *ring, Uint32 tick_ms);
+void rewind_capture(Rewind *ring, const Replay *replay,
+	const GameState *game_state, const Player *player,
+	const WeaponSystem *weapon_system);
+int rewind_back(Rewind *ring, Replay *replay, GameState *game_state,
+	Player *player, WeaponSystem *weapon_system);
+
+#endif /* SAVE_H */
@@ -0,0 +1,90 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "maze.h"
+#include "capture.h"
+#include "replay.h"
+#include "resolution.h"
+#include "jobs.h"
+#include "pacer.h"
+#include "net.h"
+#include "save.h"
+#include "effects.h"
+
+#define MAX_TICKS_PER_FRAME 5 /* Ticks caught up after a stall, at most */
+
+/**
+ * struct Session - Systems the main loop drives for one run of the game
+ * @renderer: SDL renderer
+ * @fb: Framebuffer the 3D view is rendered into
+ * @textures: Wall and floor textures
+ * @capture: Active video capture, or NULL
+ * @replay: Input replay being recorded or played back
+ * @scaler: Dynamic render resolution controller
+ * @view: Projection settings and ray tables
+ * @jobs: Render threads
+ * @rays: Full-scale render width from the config; 0 follows the window
+ * @next_tick: SDL_GetTicks() time the next simulation tick is due
+ * @lightmap: Baked level lighting plus muzzle flashes
+ * @minimap: Cached minimap wall layer
+ * @text: Glyph atlas and text batch for the HUD
+ * @stats: Frame rate, render time and input latency shown on the HUD
+ * @pacer: Sleeps the loop until the next tick is due
+ * @report_latency: 1 to print the input latency histogram on exit
+ * @input: Key events waiting for the simulation ticks they belong to
+ * @client: Server connection when watching a remote game, or NULL
+ * @rewind: Checkpoints taken every second to rewind to
+ * @rewinds: Rewinds asked for with BACKSPACE since the last frame
+ * @load_path: Save the game starts from instead of its seed, or NULL
+ * @save_path: File autosaves and the save on exit go to, or NULL
+ * @autosave: Seconds between autosaves, 0 to save only on exit
+ * @saved_tick: Tick of the last autosave
+ * @audio: Sound mixed on SDL's audio thread
+ * @cues: Game state the sound and particle cues compare each tick with
+ * @particles: Impact, muzzle and death particles drawn into the 3D view
+ */
+typedef struct Session
+{
+	SDL_Renderer *renderer;
+	Framebuffer fb;
+	Textures textures;
+	Capture *capture;
+	Replay replay;
+	ResolutionScaler scaler;
+	View view;
+	JobPool jobs;
+	int rays;
+	Uint32 next_tick;
+	Lightmap lightmap;
+	Minimap minimap;
+	TextBatch text;
+	FrameStats stats;
+	FramePacer pacer;
+	int report_latency;
+	InputQueue input;
+	Client *client;
+	Rewind rewind;
+	int rewinds;
+	const char *load_path;
+	const char *save_path;
+	int autosave;
+	Uint32 saved_tick;
+	Audio audio;
+	Cues cues;
+	Particles particles;
+} Session;
+
+int render_frame(Session *session, Player *player, GameState *game_state,
+	WeaponSystem *weapon_system);
+void handle_events(int *running, GameState *game_state, Session *session);
+void session_resize(Session *session, int width, int height);
+int remote_ticks(Session *session, GameState *game_state, Player *player,
+	WeaponSystem *weapon_system);
+int checkpoint_start(Session *session, GameState *game_state, Player *player,
+	WeaponSystem *weapon_system);
+void checkpoint_frame(Session *session, GameState *game_state,
+	Player *player, WeaponSystem *weapon_system);
+void checkpoint_finish(Session *session, const GameState *game_state,
+	const Player *player, const WeaponSystem *weapon_system);
+
+#endif /* SESSION_H */
@@ -0,0 +1,42 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <SDL2/SDL.h>
+
+#define FONT_WIDTH 5        /* Glyph width in atlas texels */
+#define FONT_HEIGHT 7       /* Glyph height in atlas texels */
+#define FONT_FIRST 32       /* First character in the atlas (space) */
+#define FONT_GLYPHS 64      /* Space to '_'; lowercase is drawn as uppercase */
+#define FONT_CELL_W 6       /* Atlas cell: glyph plus a clear gap */
+#define FONT_CELL_H 8
+#define FONT_ATLAS_COLS 16  /* Glyphs per atlas row */
+#define FONT_ATLAS_W (FONT_ATLAS_COLS * FONT_CELL_W)
+#define FONT_ATLAS_H (FONT_GLYPHS / FONT_ATLAS_COLS * FONT_CELL_H)
+#define TEXT_MAX_GLYPHS 256 /* Glyphs one batch holds */
+
+/**
+ * struct TextBatch - Quads of queued text, drawn in one geometry call
+ * @atlas: Texture holding every glyph, white on transparent
+ * @vertices: Four corners per queued glyph
+ * @indices: Two triangles per glyph; filled in once, never changes
+ * @glyphs: Glyphs queued since the last flush
+ *
+ * Everything is allocated up front, so queueing and drawing text never
+ * allocates memory or creates textures.
+ */
+typedef struct TextBatch
+{
+	SDL_Texture *atlas;
+	SDL_Vertex vertices[TEXT_MAX_GLYPHS * 4];
+	int indices[TEXT_MAX_GLYPHS * 6];
+	int glyphs;
+} TextBatch;
+
+SDL_Texture *font_atlas(SDL_Renderer *renderer);
+int text_init(TextBatch *batch, SDL_Renderer *renderer);
+int text_add(TextBatch *batch, int x, int y, int scale, SDL_Color color,
+	const char *string);
+void text_flush(TextBatch *batch, SDL_Renderer *renderer);
+void text_cleanup(TextBatch *batch);
+
+#endif /* TEXT_H */
@@ -3,6 +3,13 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include "input.h"
+#include "rng.h"
+#include "lightmap.h"
+#include "pvs.h"
+#include "minimap.h"
+#include "jobs.h"
+#include "behaviour.h"
 
 /* Maximum number of enemies and bullets */
 #define MAX_ENEMIES 10
@@ -20,6 +27,10 @@
  * @frame_time: Time of last frame change
  * @frame: Current animation frame
  * @direction: where enemy is facing
+ * @thought: Simulation time of the enemy's last AI update
+ * @mode: ENEMY_* action its behaviour script chose
+ * @goal_x: Point ENEMY_GOTO moves towards, X
+ * @goal_y: Point ENEMY_GOTO moves towards, Y
  */
 typedef struct Enemy
 {
@@ -31,6 +42,10 @@ float speed;
 Uint32 last_attack, frame_time;
 int frame;
 int direction;
+Uint32 thought;
+int mode;
+float goal_x;
+float goal_y;
 } Enemy;
 
 /**
@@ -60,6 +75,19 @@ Uint32 created;
  * @score: Player's score
  * @player_health: Player's current health
  * @last_shot_time: Time of last shot fired
+ * @time: Simulation clock in ms, advanced by a fixed step every tick
+ * @tick_ms: Length of a simulation tick; speeds are per TICK_MS and scaled
+ * @lightmap: Lightmap muzzle flashes are drawn into, or NULL
+ * @pvs: Potentially visible sets of the maze, built at init
+ * @jobs: Thread pool entity updates are split across, or NULL
+ * @ai_tier: Per enemy, AI_NEAR_TIER or AI_FAR_TIER; see ai_schedule()
+ * @ai_cursor: Enemy the next round-robin slice of far enemies starts at
+ * @behaviours: Per enemy, the state of its behaviour script
+ * @sched_next: Scheduler wheel links, see struct Scheduler
+ * @sched_prev: Scheduler wheel links, see struct Scheduler
+ * @sched_wheel: Scheduler timer wheel
+ * @sched_ready: Scripts woken this tick
+ * @sched_ready_count: Entries in @sched_ready
  * @enemy_texture: Texture for enemy sprites
  * @enemy_texture_width: Width of enemy texture
  * @enemy_texture_height: Height of enemy texture
@@ -72,28 +100,153 @@ int enemy_count;
 int score;
 int player_health;
 Uint32 last_shot_time;
+Uint32 time;
+Uint32 tick_ms;
+Lightmap *lightmap;
+Pvs pvs;
+JobPool *jobs;
+Uint8 ai_tier[MAX_ENEMIES];
+int ai_cursor;
+Behaviour behaviours[MAX_ENEMIES];
+int sched_next[MAX_ENEMIES];
+int sched_prev[MAX_ENEMIES];
+int sched_wheel[SCHED_WHEEL];
+int sched_ready[MAX_ENEMIES];
+int sched_ready_count;
 SDL_Texture *enemy_texture;
 int enemy_texture_width;
 int enemy_texture_height;
 } WeaponSystem;
 
+#define ENTITY_CHUNK 64 /* Entities per job; smaller counts run inline */
+#define BULLET_SPEED 0.2f /* Cells a bullet travels per TICK_MS */
+#define ENEMY_RADIUS 0.5f /* Distance from an enemy's center a bullet hits */
+
+/* Enemy AI level of detail (see ai_schedule()) */
+#define AI_NEAR 4.0f      /* Cells within which enemies update every tick */
+#define AI_SLICE 64       /* Other enemies updated per tick, round-robin */
+#define AI_MAX_STEP_MS 64 /* Longest step an enemy moves in at once */
+#define AI_FAR_TIER 0     /* Far or out of sight: updated in slices */
+#define AI_NEAR_TIER 1    /* Near and in sight: updated every tick */
+#define ENEMY_ATTACKS 0x20 /* EntityUpdate event: attacks this tick */
+#define ARRIVE_RADIUS 0.25f /* Distance from its goal an enemy has arrived */
+
+#define ENEMY_GRID_CELLS (15 * 15) /* One bucket per maze cell */
+
+/**
+ * struct EnemyGrid - Living enemies bucketed by the maze cells they touch
+ * @start: Per cell, where its bucket starts in @enemies; the last entry
+ * is where the last bucket ends
+ * @enemies: Enemy indices, ascending within each bucket; room for four
+ * per enemy, as an ENEMY_RADIUS circle touches at most 2x2 cells
+ *
+ * Built once per tick so a bullet only sweeps the enemies in the cells
+ * its path crosses.
+ */
+typedef struct EnemyGrid
+{
+	int start[ENEMY_GRID_CELLS + 1];
+	int *enemies;
+} EnemyGrid;
+
+/**
+ * struct BulletHit - What a bullet hit during one tick
+ * @enemy: Enemy the bullet hit first, or -1
+ * @x: X the bullet started the tick at
+ * @y: Y the bullet started the tick at
+ *
+ * The start is kept so the merge can sweep the same path again.
+ */
+typedef struct BulletHit
+{
+	int enemy;
+	float x;
+	float y;
+} BulletHit;
+
+/**
+ * struct EntityUpdate - One tick of enemy or bullet updates
+ * @enemies: Enemy array
+ * @enemy_total: Length of @enemies
+ * @bullets: Bullet array
+ * @bullet_total: Length of @bullets
+ * @player: Player the enemies chase
+ * @pvs: Potentially visible sets; enemies out of sight hold still
+ * @time: Simulation time of the tick
+ * @tick_ms: Length of the tick
+ * @hits: Per bullet, what it hit; scratch for the merge
+ * @events: Per due enemy, ENEMY_ATTACKS and the BEHAVIOUR_* events it
+ * raised this tick; scratch for the merge
+ * @due: Enemies updated this tick, from ai_schedule(); scratch
+ * @due_count: Entries in @due
+ * @tiers: Per enemy, AI_NEAR_TIER or AI_FAR_TIER
+ * @ai_cursor: Enemy the next round-robin slice starts at
+ * @score: Score, raised for every kill
+ * @enemy_count: Living enemies, lowered for every kill
+ * @player_health: Player health, lowered for every attack
+ * @scheduler: Behaviours the merges signal events to, or NULL
+ * @grid: Enemy buckets for the bullet update, rebuilt by it; scratch
+ *
+ * Each entity is updated on its own in parallel chunks, writing only to
+ * itself and its scratch slot. Everything shared is then written by a
+ * serial merge in entity order, so the result is the same for any
+ * number of threads and matches a plain serial loop.
+ */
+typedef struct EntityUpdate
+{
+	Enemy *enemies;
+	int enemy_total;
+	Bullet *bullets;
+	int bullet_total;
+	const Player *player;
+	const Pvs *pvs;
+	Uint32 time;
+	Uint32 tick_ms;
+	BulletHit *hits;
+	Uint8 *events;
+	int *due;
+	int due_count;
+	Uint8 *tiers;
+	int *ai_cursor;
+	int *score;
+	int *enemy_count;
+	int *player_health;
+	Scheduler *scheduler;
+	EnemyGrid *grid;
+} EntityUpdate;
+
+void entities_update_bullets(EntityUpdate *update, JobPool *jobs);
+int entities_update_enemies(EntityUpdate *update, JobPool *jobs);
+int ai_schedule(EntityUpdate *update);
+void entity_update_init(EntityUpdate *update, WeaponSystem *weapon_system,
+	const Player *player, BulletHit *hits, Uint8 *events, int *due);
+int run_entity_bench(int count);
+
+/* Enemy behaviour scripts */
+void scheduler_init(Scheduler *scheduler, WeaponSystem *weapon_system);
+void start_behaviours(WeaponSystem *weapon_system);
+void resume_behaviours(WeaponSystem *weapon_system);
+int update_behaviours(WeaponSystem *weapon_system);
+
 /* Surface manipulation functions */
 SDL_Surface *resize_surface(SDL_Surface *surface, int width, int height);
 SDL_Surface *load_weapon_image(const char *filename, int width, int height);
 SDL_Surface *create_weapon_sprite(int width, int height);
 
 /* Weapon system initialization and cleanup */
-int init_weapon_system(WeaponSystem *weapon_system, const int maze[15][15]);
+int init_weapon_system(WeaponSystem *weapon_system, const int maze[15][15],
+Rng *rng);
 void cleanup_weapon_system(void);
 void cleanup_weapon_sprite(Player *player);
 
 /* Enemy management functions */
-void init_enemies(WeaponSystem *weapon_system, const int maze[15][15]);
+void init_enemies(WeaponSystem *weapon_system, const int maze[15][15],
+Rng *rng);
 void update_enemies(WeaponSystem *weapon_system, Player *player);
 int check_collision(const int maze[15][15], float x, float y);
 int has_line_of_sight(float start_x, float start_y, float end_x, float end_y);
-void draw_minimap_enemies(SDL_Renderer *renderer, int map_x, int map_y,
-int cell_size, WeaponSystem *weapon_system);
+void draw_minimap_enemies(SDL_Renderer *renderer, const MinimapView *view,
+WeaponSystem *weapon_system, const Player *player);
 
 /* Bullet management functions */
 void create_bullet(WeaponSystem *weapon_system, Player *player);
@@ -101,18 +254,18 @@ void update_bullets(WeaponSystem *weapon_system);
 
 /* Shooting mechanics */
 void handle_shooting(WeaponSystem *weapon_system, Player *player,
-const Uint8 *keyboard);
+const Input *input);
 
 /* Update and render functions */
 void update_weapon_system(WeaponSystem *weapon_system, Player *player,
-					const Uint8 *keyboard, const int maze[15][15]);
+					const Input *input, const int maze[15][15], Rng *rng);
 void render_weapon_system(SDL_Renderer *renderer, Player *player,
-					WeaponSystem *weapon_system);
+					WeaponSystem *weapon_system, const Input *input, float fov);
 
-/* HUD and enemy rendering */
-void draw_bullets_minimap(SDL_Renderer *renderer, WeaponSystem *weapon_system);
+/* Minimap and enemy rendering */
+void draw_bullets_minimap(SDL_Renderer *renderer, const MinimapView *view,
+WeaponSystem *weapon_system);
 void draw_enemies_3d(SDL_Renderer *renderer, Player *player,
-			WeaponSystem *weapon_system);
-void draw_hud(SDL_Renderer *renderer, WeaponSystem *weapon_system);
+			WeaponSystem *weapon_system, float fov);
 
 #endif /* WEAPON_SPRITES_H */
@@ -0,0 +1,152 @@
+#include "../inc/audio.h"
+#include <string.h>
+
+/**
+ * audio_apply - Carries out one command on the audio thread
+ * @audio: Audio output
+ * @command: Command popped from the ring
+ *
+ * With every voice busy a new sound takes over the one furthest along,
+ * which is the closest to ending anyway.
+ */
+static void audio_apply(Audio *audio, const AudioCommand *command)
+{
+	Voice *voice, *pick = NULL;
+	int i;
+
+	if (command->type == AUDIO_VOLUME)
+	{
+		audio->volume = command->left;
+		return;
+	}
+	for (i = 0; i < AUDIO_VOICES; i++)
+	{
+		voice = &audio->voices[i];
+		if (command->type == AUDIO_STOP)
+		{
+			if (command->sound == SOUND_ALL ||
+				voice->sound == &audio->sounds[command->sound])
+				voice->sound = NULL;
+			continue;
+		}
+		if (!pick || (pick->sound && (!voice->sound || voice->pos > pick->pos)))
+			pick = voice;
+	}
+	if (command->type != AUDIO_PLAY || command->sound >= SOUND_COUNT)
+		return;
+	pick->sound = &audio->sounds[command->sound];
+	pick->pos = 0;
+	pick->left = command->left;
+	pick->right = command->right;
+}
+
+/**
+ * audio_mix - SDL audio callback; mixes the voices into the output
+ * @data: Audio output
+ * @stream: Interleaved signed 16-bit stereo buffer to fill
+ * @len: Size of @stream in bytes
+ *
+ * Runs on SDL's audio thread. It takes no lock and allocates nothing:
+ * the commands that arrived are applied, then the voices are summed in
+ * float and clipped, AUDIO_SAMPLES frames at a time.
+ */
+static void audio_mix(void *data, Uint8 *stream, int len)
+{
+	Audio *audio = data;
+	Sint16 *out = (Sint16 *)stream;
+	float mix[AUDIO_SAMPLES * 2], sample;
+	int tail = SDL_AtomicGet(&audio->tail);
+	int head = SDL_AtomicGet(&audio->head);
+	int frames = len / (int)(2 * sizeof(Sint16)), done, n, i, v, count;
+	Voice *voice;
+
+	for (; tail != head; tail++)
+		audio_apply(audio, &audio->commands[tail & (AUDIO_QUEUE_SIZE - 1)]);
+	SDL_AtomicSet(&audio->tail, tail);
+	for (done = 0; done < frames; done += n)
+	{
+		n = frames - done < AUDIO_SAMPLES ? frames - done : AUDIO_SAMPLES;
+		memset(mix, 0, sizeof(float) * 2 * n);
+		for (v = 0; v < AUDIO_VOICES; v++)
+		{
+			voice = &audio->voices[v];
+			if (!voice->sound)
+				continue;
+			count = voice->sound->length - voice->pos;
+			count = count < n ? count : n;
+			for (i = 0; i < count; i++)
+			{
+				sample = voice->sound->pcm[voice->pos + i];
+				mix[2 * i] += sample * voice->left;
+				mix[2 * i + 1] += sample * voice->right;
+			}
+			voice->pos += count;
+			if (voice->pos >= voice->sound->length)
+				voice->sound = NULL;
+		}
+		for (i = 0; i < 2 * n; i++)
+		{
+			sample = mix[i] * audio->volume;
+			sample = sample > 32767.0f ? 32767.0f : sample;
+			out[2 * done + i] = sample < -32768.0f ? -32768 : (Sint16)sample;
+		}
+	}
+}
+
+/**
+ * audio_open - Starts mixing sound on SDL's audio thread
+ * @audio: Audio output to set up
+ * @volume: Master volume, 0 to 100; 0 opens no device at all
+ * Return: 0 on success or when silent by choice, -1 if no sound could be
+ * opened; the game then runs silent
+ *
+ * Sounds are built before the device starts, so the callback never
+ * waits for them. SDL_AUDIODRIVER=dummy or disk picks a driver that
+ * needs no sound hardware.
+ */
+int audio_open(Audio *audio, int volume)
+{
+	SDL_AudioSpec want;
+
+	memset(audio, 0, sizeof(*audio));
+	audio->volume = volume / 100.0f;
+	if (volume <= 0)
+		return (0);
+	if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0)
+	{
+		printf("Cannot start audio: %s\n", SDL_GetError());
+		return (-1);
+	}
+	memset(&want, 0, sizeof(want));
+	want.freq = AUDIO_RATE;
+	want.format = AUDIO_S16SYS;
+	want.channels = 2;
+	want.samples = AUDIO_SAMPLES;
+	want.callback = audio_mix;
+	want.userdata = audio;
+	if (sounds_build(audio->sounds) == 0)
+		audio->device = SDL_OpenAudioDevice(NULL, 0, &want, NULL, 0);
+	if (!audio->device)
+	{
+		printf("Cannot open audio: %s\n", SDL_GetError());
+		sounds_free(audio->sounds);
+		SDL_QuitSubSystem(SDL_INIT_AUDIO);
+		return (-1);
+	}
+	SDL_PauseAudioDevice(audio->device, 0);
+	return (0);
+}
+
+/**
+ * audio_close - Stops the audio thread and frees the sounds
+ * @audio: Audio output passed to audio_open()
+ */
+void audio_close(Audio *audio)
+{
+	if (!audio->device)
+		return;
+	SDL_CloseAudioDevice(audio->device);
+	audio->device = 0;
+	sounds_free(audio->sounds);
+	SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
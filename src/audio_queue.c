@@ -0,0 +1,85 @@
+#include "../inc/audio.h"
+
+/**
+ * audio_push - Hands a command to the audio thread
+ * @audio: Audio output
+ * @command: Command to copy into the ring
+ *
+ * Never waits: with the ring full, which takes AUDIO_QUEUE_SIZE commands
+ * within one callback period, the command is dropped and counted.
+ */
+static void audio_push(Audio *audio, const AudioCommand *command)
+{
+	int head;
+
+	if (!audio->device)
+		return;
+	head = SDL_AtomicGet(&audio->head);
+	if (head - SDL_AtomicGet(&audio->tail) == AUDIO_QUEUE_SIZE)
+	{
+		SDL_AtomicAdd(&audio->dropped, 1);
+		return;
+	}
+	audio->commands[head & (AUDIO_QUEUE_SIZE - 1)] = *command;
+	SDL_AtomicSet(&audio->head, head + 1); /* Publishes the slot */
+}
+
+/**
+ * audio_play - Plays a sound from a point in the maze
+ * @audio: Audio output
+ * @sound: SOUND_* to play
+ * @x: X of the source
+ * @y: Y of the source
+ * @listener: Player hearing it
+ *
+ * The gain falls off with distance as 1 / (1 + AUDIO_ROLLOFF * d), and
+ * the sound is panned by where the source lies relative to where the
+ * player faces, keeping the total power the same.
+ */
+void audio_play(Audio *audio, int sound, float x, float y,
+		const Player *listener)
+{
+	AudioCommand command;
+	float dx = x - listener->x, dy = y - listener->y;
+	float distance = sqrtf(dx * dx + dy * dy), gain, pan = 0.0f;
+
+	if (sound < 0 || sound >= SOUND_COUNT)
+		return;
+	gain = 1.0f / (1.0f + AUDIO_ROLLOFF * distance);
+	if (distance > 0.01f)
+		pan = sinf(atan2f(dy, dx) - listener->angle);
+	command.type = AUDIO_PLAY;
+	command.sound = sound;
+	command.left = gain * sqrtf((1.0f - pan) * 0.5f);
+	command.right = gain * sqrtf((1.0f + pan) * 0.5f);
+	audio_push(audio, &command);
+}
+
+/**
+ * audio_stop - Cuts every voice playing a sound
+ * @audio: Audio output
+ * @sound: SOUND_* to stop, or SOUND_ALL
+ */
+void audio_stop(Audio *audio, int sound)
+{
+	AudioCommand command = {AUDIO_STOP, 0, 0.0f, 0.0f};
+
+	if (sound != SOUND_ALL && (sound < 0 || sound >= SOUND_COUNT))
+		return;
+	command.sound = sound;
+	audio_push(audio, &command);
+}
+
+/**
+ * audio_volume - Sets the master volume
+ * @audio: Audio output
+ * @volume: 0 to 100
+ */
+void audio_volume(Audio *audio, int volume)
+{
+	AudioCommand command = {AUDIO_VOLUME, 0, 0.0f, 0.0f};
+
+	volume = volume < 0 ? 0 : volume > 100 ? 100 : volume;
+	command.left = volume / 100.0f;
+	audio_push(audio, &command);
+}
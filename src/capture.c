@@ -0,0 +1,144 @@
+#include "../inc/capture.h"
+#include <string.h>
+
+/**
+ * capture_thread - Writer thread: converts and writes submitted frames
+ * @data: Pointer to the Capture
+ * Return: 0
+ */
+static int capture_thread(void *data)
+{
+	Capture *capture = data;
+	int slot;
+
+	while (1)
+	{
+		SDL_SemWait(capture->ready);
+		if (SDL_AtomicGet(&capture->tail) == SDL_AtomicGet(&capture->head))
+			break; /* Woken by capture_stop with nothing left */
+		slot = SDL_AtomicGet(&capture->tail) % CAPTURE_SLOTS;
+		if (capture_write_frame(capture, capture->slots[slot],
+			capture->slot_width[slot], capture->slot_height[slot]) == 0)
+			capture->frames_written++;
+		SDL_AtomicAdd(&capture->tail, 1);
+	}
+	return (0);
+}
+
+/**
+ * capture_start - Opens the output file and starts the writer thread
+ * @capture: Capture to initialize
+ * @path: Output path; ".y4m" selects YUV4MPEG2, anything else raw RGB24
+ * @width: Frame width; must equal the framebuffer pitch
+ * @height: Largest frame height
+ * Return: 0 on success, -1 on failure
+ */
+int capture_start(Capture *capture, const char *path, int width, int height)
+{
+	if (capture_open(capture, path, width, height) != 0)
+	{
+		printf("Capture to %s failed to start\n", path);
+		capture_stop(capture);
+		return (-1);
+	}
+	SDL_AtomicSet(&capture->running, 1);
+	capture->thread = SDL_CreateThread(capture_thread, "capture", capture);
+	if (!capture->thread)
+	{
+		printf("Capture thread creation failed: %s\n", SDL_GetError());
+		capture_stop(capture);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * capture_acquire - Points the framebuffer at a free ring slot
+ * @capture: Capture, or NULL when not recording
+ * @fb: Framebuffer about to be rendered
+ *
+ * If the writer has fallen CAPTURE_SLOTS frames behind, or the window has
+ * been resized beyond the recording size, the frame is rendered into the
+ * framebuffer's own buffer and counted as dropped.
+ */
+void capture_acquire(Capture *capture, Framebuffer *fb)
+{
+	Uint64 start;
+	int head;
+
+	fb->pixels = fb->backing;
+	if (!capture || !SDL_AtomicGet(&capture->running))
+		return;
+	/* Every recorded frame is rendered in full into its own slot */
+	fb->valid = 0;
+	start = SDL_GetPerformanceCounter();
+	head = SDL_AtomicGet(&capture->head);
+	/* Slots are sized for the window the capture started with */
+	if (head - SDL_AtomicGet(&capture->tail) < CAPTURE_SLOTS &&
+		fb->pitch == capture->width && fb->max_height <= capture->height)
+	{
+		fb->pixels = capture->slots[head % CAPTURE_SLOTS];
+		capture->acquired = 1;
+	}
+	else
+	{
+		capture->frames_dropped++;
+	}
+	capture->overhead_ticks += SDL_GetPerformanceCounter() - start;
+}
+
+/**
+ * capture_submit - Hands the rendered slot to the writer thread
+ * @capture: Capture, or NULL when not recording
+ * @fb: Framebuffer that was rendered
+ *
+ * The render thread must not touch the slot again; the next
+ * capture_acquire() moves the framebuffer on to another buffer.
+ */
+void capture_submit(Capture *capture, Framebuffer *fb)
+{
+	Uint64 start;
+	int slot;
+
+	if (!capture || !capture->acquired)
+		return;
+	start = SDL_GetPerformanceCounter();
+	slot = SDL_AtomicGet(&capture->head) % CAPTURE_SLOTS;
+	capture->slot_width[slot] = fb->width;
+	capture->slot_height[slot] = fb->height;
+	capture->acquired = 0;
+	fb->pixels = fb->backing;
+	SDL_AtomicAdd(&capture->head, 1);
+	SDL_SemPost(capture->ready);
+	capture->overhead_ticks += SDL_GetPerformanceCounter() - start;
+}
+
+/**
+ * capture_stop - Drains the ring, stops the writer and reports statistics
+ * @capture: Capture to stop
+ */
+void capture_stop(Capture *capture)
+{
+	int i, frames;
+
+	if (capture->thread)
+	{
+		SDL_AtomicSet(&capture->running, 0);
+		SDL_SemPost(capture->ready);
+		SDL_WaitThread(capture->thread, NULL);
+		frames = capture->frames_written + capture->frames_dropped;
+		printf("Capture: %d frames written, %d dropped, %.3f ms/frame "
+			"render-thread overhead\n", capture->frames_written,
+			capture->frames_dropped, frames ? capture->overhead_ticks *
+			1000.0 / SDL_GetPerformanceFrequency() / frames : 0.0);
+	}
+	if (capture->file)
+		fclose(capture->file);
+	if (capture->ready)
+		SDL_DestroySemaphore(capture->ready);
+	for (i = 0; i < CAPTURE_SLOTS; i++)
+		free(capture->slots[i]);
+	free(capture->scratch);
+	free(capture->resized);
+	memset(capture, 0, sizeof(*capture));
+}
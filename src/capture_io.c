@@ -0,0 +1,167 @@
+#include "../inc/capture.h"
+#include <string.h>
+
+/**
+ * capture_open - Allocates the ring and opens the output file
+ * @capture: Capture to initialize
+ * @path: Output path; ".y4m" selects YUV4MPEG2, anything else raw RGB24
+ * @width: Frame width
+ * @height: Frame height
+ * Return: 0 on success, -1 on failure (partial state freed by capture_stop)
+ */
+int capture_open(Capture *capture, const char *path, int width, int height)
+{
+	size_t len = strlen(path);
+	int i, ok = 1;
+
+	memset(capture, 0, sizeof(*capture));
+	capture->width = width;
+	capture->height = height;
+	capture->format = (len > 4 && strcmp(path + len - 4, ".y4m") == 0) ?
+		CAPTURE_Y4M : CAPTURE_RGB;
+	for (i = 0; i < CAPTURE_SLOTS; i++)
+	{
+		capture->slots[i] = malloc(sizeof(Uint32) * width * height);
+		if (!capture->slots[i])
+			ok = 0;
+	}
+	capture->scratch = malloc((size_t)width * height * 3);
+	capture->resized = malloc(sizeof(Uint32) * width * height);
+	capture->ready = SDL_CreateSemaphore(0);
+	capture->file = fopen(path, "wb");
+	if (!ok || !capture->scratch || !capture->resized || !capture->ready ||
+		!capture->file)
+		return (-1);
+
+	/* Whole frames are written at once; a large buffer avoids extra copies */
+	setvbuf(capture->file, NULL, _IOFBF, 1 << 20);
+	if (capture->format == CAPTURE_Y4M)
+		fprintf(capture->file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+			width, height, CAPTURE_FPS);
+	return (0);
+}
+
+/**
+ * convert_chroma - Averages a 2x2 block into one JPEG-range U/V sample
+ * @pixels: Frame pixels
+ * @capture: Capture holding the frame dimensions
+ * @x: Left column of the block
+ * @y: Top row of the block
+ * @uv: Receives U in uv[0] and V in uv[1]
+ */
+static void convert_chroma(const Uint32 *pixels, const Capture *capture,
+			int x, int y, Uint8 *uv)
+{
+	int r = 0, g = 0, b = 0, n = 0, dx, dy;
+	Uint32 p;
+
+	for (dy = 0; dy < 2 && y + dy < capture->height; dy++)
+		for (dx = 0; dx < 2 && x + dx < capture->width; dx++)
+		{
+			p = pixels[(y + dy) * capture->width + x + dx];
+			r += (p >> 16) & 0xFF;
+			g += (p >> 8) & 0xFF;
+			b += p & 0xFF;
+			n++;
+		}
+	r /= n;
+	g /= n;
+	b /= n;
+	uv[0] = (Uint8)(((-43 * r - 85 * g + 128 * b) >> 8) + 128);
+	uv[1] = (Uint8)(((128 * r - 107 * g - 21 * b) >> 8) + 128);
+}
+
+/**
+ * convert_y4m - Converts an ARGB frame to planar 4:2:0 YUV
+ * @capture: Capture holding dimensions and the scratch buffer
+ * @pixels: Frame pixels
+ * Return: Size of the converted frame in bytes
+ */
+static size_t convert_y4m(Capture *capture, const Uint32 *pixels)
+{
+	int w = capture->width, h = capture->height;
+	int cw = (w + 1) / 2, ch = (h + 1) / 2, x, y;
+	Uint8 *y_plane = capture->scratch;
+	Uint8 *u_plane = y_plane + w * h, *v_plane = u_plane + cw * ch;
+	Uint8 uv[2];
+	Uint32 p;
+
+	for (y = 0; y < h; y++)
+		for (x = 0; x < w; x++)
+		{
+			p = pixels[y * w + x];
+			y_plane[y * w + x] = (Uint8)((77 * ((p >> 16) & 0xFF) +
+				150 * ((p >> 8) & 0xFF) + 29 * (p & 0xFF)) >> 8);
+		}
+	for (y = 0; y < ch; y++)
+		for (x = 0; x < cw; x++)
+		{
+			convert_chroma(pixels, capture, x * 2, y * 2, uv);
+			u_plane[y * cw + x] = uv[0];
+			v_plane[y * cw + x] = uv[1];
+		}
+	return ((size_t)w * h + (size_t)cw * ch * 2);
+}
+
+/**
+ * upscale_frame - Nearest-neighbour scales a reduced-size frame to full size
+ * @capture: Capture holding the full dimensions and the resize buffer
+ * @pixels: Frame pixels, rows capture->width apart
+ * @width: Rendered width
+ * @height: Rendered height
+ * Return: The upscaled frame
+ */
+static const Uint32 *upscale_frame(Capture *capture, const Uint32 *pixels,
+			int width, int height)
+{
+	const Uint32 *src;
+	Uint32 *dst = capture->resized;
+	int x, y;
+
+	for (y = 0; y < capture->height; y++)
+	{
+		src = pixels + (y * height / capture->height) * capture->width;
+		for (x = 0; x < capture->width; x++)
+			*dst++ = src[x * width / capture->width];
+	}
+	return (capture->resized);
+}
+
+/**
+ * capture_write_frame - Converts one frame and appends it to the file
+ * @capture: Capture being written
+ * @pixels: ARGB8888 frame pixels, rows capture->width apart
+ * @width: Width the frame was rendered at
+ * @height: Height the frame was rendered at
+ * Return: 0 on success, -1 on write failure
+ *
+ * Runs on the writer thread, so scaling and conversion never cost
+ * render time.
+ */
+int capture_write_frame(Capture *capture, const Uint32 *pixels,
+			int width, int height)
+{
+	size_t size, i, count = (size_t)capture->width * capture->height;
+	Uint8 *out = capture->scratch;
+
+	if (width != capture->width || height != capture->height)
+		pixels = upscale_frame(capture, pixels, width, height);
+
+	if (capture->format == CAPTURE_Y4M)
+	{
+		size = convert_y4m(capture, pixels);
+		if (fputs("FRAME\n", capture->file) == EOF)
+			return (-1);
+	}
+	else
+	{
+		for (i = 0; i < count; i++)
+		{
+			out[i * 3] = (pixels[i] >> 16) & 0xFF;
+			out[i * 3 + 1] = (pixels[i] >> 8) & 0xFF;
+			out[i * 3 + 2] = pixels[i] & 0xFF;
+		}
+		size = count * 3;
+	}
+	return (fwrite(capture->scratch, 1, size, capture->file) == size ? 0 : -1);
+}
@@ -0,0 +1,107 @@
+#include "../inc/fixed.h"
+
+/**
+ * struct CastJob - Everything a worker needs to render a range of columns
+ * @fb: Framebuffer to draw on
+ * @view: Projection settings and ray tables
+ * @player: Camera
+ * @maze: Maze layout
+ * @textures: Wall and floor textures
+ * @lightmap: Per-cell lighting, or NULL
+ */
+struct CastJob
+{
+	Framebuffer *fb;
+	const View *view;
+	const Player *player;
+	const int (*maze)[15];
+	Textures *textures;
+	const Lightmap *lightmap;
+};
+
+/**
+ * cast_column - Casts one ray and draws its walls, floor and ceiling
+ * @job: Render job
+ * @x: Column to draw
+ *
+ * Hits are drawn back to front over the floor, so grates and low walls
+ * show what lies behind them. The distance to the opaque wall is kept
+ * in the depth buffer for what is drawn into the view afterwards.
+ */
+static void cast_column(const struct CastJob *job, int x)
+{
+	WallHit hits[MAX_WALL_HITS];
+	float ray_angle = job->player->angle + job->view->ray_angle[x];
+	int count, i, level, wall_height = 0, far_height = 0;
+
+	count = trace_ray(job->maze, job->player, ray_angle,
+		job->view->max_depth, hits);
+	job->fb->depth[x] = job->view->max_depth;
+	if (count > 0 && (hits[count - 1].type == CELL_WALL ||
+		hits[count - 1].type == CELL_DOOR))
+	{
+		job->fb->depth[x] = hits[count - 1].distance;
+		far_height = (int)((int)(job->fb->height /
+			hits[count - 1].distance) * 0.8);
+	}
+	draw_floor(job->fb, job->view, x, far_height, job->player, ray_angle,
+		job->textures, job->lightmap);
+	for (i = count - 1; i >= 0; i--)
+	{
+		wall_height = (int)((int)(job->fb->height / hits[i].distance) * 0.8);
+		/* A face is lit by the open cell in front of it */
+		level = light_level(hits[i].distance) + lightmap_sample(job->lightmap,
+			hits[i].front_x + 0.5f, hits[i].front_y + 0.5f);
+		draw_textured_wall(job->fb, x, wall_height, &hits[i],
+			LIGHT_CLAMP(level), job->textures);
+	}
+}
+
+/**
+ * cast_column_range - Job body rendering columns [begin, end)
+ * @context: Pointer to the CastJob
+ * @begin: First column
+ * @end: One past the last column
+ */
+static void cast_column_range(void *context, int begin, int end)
+{
+	int x;
+
+	for (x = begin; x < end; x++)
+		cast_column(context, x);
+}
+
+/**
+ * cast_rays - Cast rays and render the 3D view
+ * @fb: Framebuffer to draw on
+ * @view: Projection settings, ray tables and render threads
+ * @player: Player structure containing position and angle
+ * @maze: 2D array representing the maze layout
+ * @textures: Pointer to the Textures structure to be initialized
+ * @lightmap: Per-cell lighting, or NULL to shade by distance only
+ *
+ * Columns only write their own pixels, so they are split across the
+ * view's render threads in small interleaved chunks. A view set to
+ * fixed point is rendered by cast_rays_fixed() instead.
+ */
+void cast_rays(Framebuffer *fb, View *view, Player *player,
+			const int maze[15][15], Textures *textures,
+			const Lightmap *lightmap)
+{
+	struct CastJob job;
+
+	if (view_update(view, fb->width, fb->height) != 0)
+		return;
+	if (view->fixed)
+	{
+		cast_rays_fixed(fb, view, player, maze, textures, lightmap);
+		return;
+	}
+	job.fb = fb;
+	job.view = view;
+	job.player = player;
+	job.maze = maze;
+	job.textures = textures;
+	job.lightmap = lightmap;
+	job_pool_run(view->jobs, cast_column_range, &job, fb->width, 16);
+}
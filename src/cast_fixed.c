@@ -0,0 +1,198 @@
+#include "../inc/fixed.h"
+
+#define TEX_STEP_SHIFT 24 /* Fraction bits of the texture row step */
+
+/**
+ * struct FixedJob - Everything a worker needs to render a range of
+ * columns in fixed point
+ * @fb: Framebuffer to draw on
+ * @view: Projection settings and ray tables
+ * @maze: Maze layout
+ * @textures: Wall and floor textures
+ * @lightmap: Per-cell lighting, or NULL
+ * @origin: Camera position (x, y)
+ * @angle: Camera direction as a binary angle
+ * @max_depth: Maximum ray distance
+ */
+struct FixedJob
+{
+	Framebuffer *fb;
+	const View *view;
+	const int (*maze)[15];
+	Textures *textures;
+	const Lightmap *lightmap;
+	Fixed origin[2];
+	Uint32 angle;
+	Fixed max_depth;
+};
+
+/**
+ * draw_wall_fixed - Draws one wall, door or grate column
+ * @fb: Framebuffer to draw into
+ * @x: Screen X position
+ * @wall_height: Height of a full wall at the hit's distance
+ * @hit: What the ray hit
+ * @level: Light level of the face
+ * @textures: Wall and floor textures
+ *
+ * As draw_textured_wall(), but the texture row is stepped through in
+ * fixed point instead of divided out for every pixel. The step rounds up
+ * and has enough fraction bits that it lands on the same texel row as
+ * the division for every wall shorter than 4096 pixels.
+ */
+static void draw_wall_fixed(Framebuffer *fb, int x, int wall_height,
+		const FixedHit *hit, int level, const Textures *textures)
+{
+	const Uint32 *column = hit->type == CELL_GRATE ? textures->grate_shades :
+		hit->type == CELL_DOOR ? textures->floor_shades :
+		hit->side == 0 ? textures->ns_shades : textures->ew_shades;
+	Uint32 *pixel, texel, step, pos;
+	int top, y, y_end, row_step = FB_ROW_STEP(fb);
+
+	if (wall_height <= 0)
+		return;
+	column += level * TEXELS + ((hit->tex_x * TEXTURE_SIZE) >> FIX_SHIFT);
+	top = (fb->height - wall_height) / 2;
+	y = hit->type != CELL_LOW_WALL ? 0 : wall_height - (int)(((Sint64)
+		wall_height * FIX_FROM_FLOAT(LOW_WALL_HEIGHT)) >> FIX_SHIFT);
+	y = top + y < 0 ? -top : y;
+	y_end = top + wall_height > fb->height ? fb->height - top : wall_height;
+	step = ((TEXTURE_SIZE << TEX_STEP_SHIFT) + wall_height - 1) / wall_height;
+	pos = y * step;
+	pixel = FB_COLUMN(fb, x) + (top + y) * row_step;
+	for (; y < y_end; y++, pos += step, pixel += row_step)
+	{
+		texel = column[(pos >> TEX_STEP_SHIFT) * TEXTURE_SIZE];
+		if (texel || hit->type != CELL_GRATE)
+			*pixel = texel; /* Grate holes leave what is behind */
+	}
+}
+
+/**
+ * draw_floor_fixed - Draws a textured floor and ceiling column
+ * @job: Render job
+ * @x: Screen X position
+ * @wall_height: Height of the opaque wall of this column
+ * @dir: Ray direction (x, y), in 2.30 fixed point
+ *
+ * As draw_floor(), with the world position of each row taken from the
+ * view's fixed-point row distances.
+ */
+static void draw_floor_fixed(const struct FixedJob *job, int x,
+		int wall_height, const Sint32 *dir)
+{
+	Framebuffer *fb = job->fb;
+	const Uint32 *floor_shades = job->textures->floor_shades;
+	const Uint32 *ceiling_shades = job->textures->ceiling_shades;
+	int wall_bottom = (fb->height + wall_height) / 2;
+	Uint32 *out = FB_COLUMN(fb, x);
+	Fixed distance, world_x, world_y;
+	int texel, y, level, step = FB_ROW_STEP(fb);
+
+	/* The horizon row itself is at infinite distance */
+	if (wall_bottom <= fb->height / 2)
+		wall_bottom = fb->height / 2 + 1;
+	for (y = wall_bottom; y < fb->height; y++)
+	{
+		distance = job->view->row_fixed[y];
+		world_x = job->origin[0] + FIX_MUL_TRIG(distance, dir[0]);
+		world_y = job->origin[1] + FIX_MUL_TRIG(distance, dir[1]);
+		level = job->view->row_light[y] +
+			fixed_light(job->lightmap, world_x, world_y);
+		level = LIGHT_CLAMP(level);
+		texel = (level * TEXTURE_SIZE + (((world_y * TEXTURE_SIZE) >>
+			FIX_SHIFT) & (TEXTURE_SIZE - 1))) * TEXTURE_SIZE +
+			(((world_x * TEXTURE_SIZE) >> FIX_SHIFT) & (TEXTURE_SIZE - 1));
+		out[y * step] = floor_shades[texel];
+		out[(fb->height - y) * step] = ceiling_shades[texel];
+	}
+}
+
+/**
+ * cast_fixed_column - Casts one ray and draws its walls, floor and ceiling
+ * @job: Render job
+ * @x: Column to draw
+ *
+ * As cast_column(): hits are drawn back to front over the floor, and the
+ * distance to the opaque wall goes into the depth buffer.
+ */
+static void cast_fixed_column(const struct FixedJob *job, int x)
+{
+	FixedHit hits[MAX_WALL_HITS];
+	int heights[MAX_WALL_HITS];
+	Uint32 angle = job->angle + job->view->ray_turn[x];
+	Sint32 dir[2] = {fixed_lookup(fixed_tables.cos, angle),
+		fixed_lookup(fixed_tables.cos, angle - FIX_QUARTER)};
+	int count, i, light, level, far_height = 0;
+
+	count = trace_ray_fixed(job->maze, job->origin, angle, job->max_depth,
+		hits);
+	for (i = 0; i < count; i++)
+		heights[i] = (job->fb->height << FIX_SHIFT) /
+			(hits[i].distance > 0 ? hits[i].distance : 1) * 4 / 5;
+	job->fb->depth[x] = job->view->max_depth;
+	if (count > 0 && (hits[count - 1].type == CELL_WALL ||
+		hits[count - 1].type == CELL_DOOR))
+	{
+		job->fb->depth[x] = FIX_TO_FLOAT(hits[count - 1].distance);
+		far_height = heights[count - 1];
+	}
+	draw_floor_fixed(job, x, far_height, dir);
+	for (i = count - 1; i >= 0; i--)
+	{
+		light = hits[i].distance >> FIX_LIGHT_SHIFT;
+		/* A face is lit by the open cell in front of it */
+		level = fixed_tables.light[light < FIX_LIGHT_STEPS ? light :
+			FIX_LIGHT_STEPS - 1] + fixed_light(job->lightmap,
+			(hits[i].front_x << FIX_SHIFT) + FIX_ONE / 2,
+			(hits[i].front_y << FIX_SHIFT) + FIX_ONE / 2);
+		draw_wall_fixed(job->fb, x, heights[i], &hits[i], LIGHT_CLAMP(level),
+			job->textures);
+	}
+}
+
+/**
+ * cast_fixed_range - Job body rendering columns [begin, end)
+ * @context: Pointer to the FixedJob
+ * @begin: First column
+ * @end: One past the last column
+ */
+static void cast_fixed_range(void *context, int begin, int end)
+{
+	int x;
+
+	for (x = begin; x < end; x++)
+		cast_fixed_column(context, x);
+}
+
+/**
+ * cast_rays_fixed - Renders the 3D view in 16.16 fixed point
+ * @fb: Framebuffer to draw on
+ * @view: Projection settings, ray tables and render threads, already
+ * updated for the framebuffer's size
+ * @player: Camera
+ * @maze: Maze layout
+ * @textures: Wall and floor textures
+ * @lightmap: Per-cell lighting, or NULL to shade by distance only
+ *
+ * The camera is converted to fixed point once per frame; from there on
+ * every column is walked, lit and textured with integer arithmetic and
+ * table lookups only, for CPUs where float trig and division are slow.
+ */
+void cast_rays_fixed(Framebuffer *fb, const View *view, const Player *player,
+		const int maze[15][15], Textures *textures, const Lightmap *lightmap)
+{
+	struct FixedJob job;
+
+	fixed_tables_init();
+	job.fb = fb;
+	job.view = view;
+	job.maze = maze;
+	job.textures = textures;
+	job.lightmap = lightmap;
+	job.origin[0] = FIX_FROM_FLOAT(player->x);
+	job.origin[1] = FIX_FROM_FLOAT(player->y);
+	job.angle = (Uint32)(Sint64)((double)player->angle * FIX_ANGLE_SCALE);
+	job.max_depth = FIX_FROM_FLOAT(view->max_depth);
+	job_pool_run(view->jobs, cast_fixed_range, &job, fb->width, 16);
+}
@@ -0,0 +1,81 @@
+#include "../inc/maze.h"
+#include "../inc/session.h"
+
+/**
+ * checkpoint_start - Loads the starting save and takes the first checkpoint
+ * @session: Session holding the save paths, replay and checkpoint ring
+ * @game_state: Game just set up by game_init()
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure, with its
+ * lightmap attached
+ * Return: 0 on success, -1 if the save could not be loaded
+ *
+ * A loaded game runs at the tick length it was saved at.
+ */
+int checkpoint_start(Session *session, GameState *game_state, Player *player,
+		WeaponSystem *weapon_system)
+{
+	if (session->load_path)
+	{
+		if (load_file(session->load_path, game_state, player,
+			weapon_system) != 0)
+			return (-1);
+		session->replay.tick_ms = weapon_system->tick_ms;
+		printf("Loaded %s at tick %u\n", session->load_path,
+			(unsigned int)game_state->tick);
+	}
+	session->saved_tick = game_state->tick;
+	rewind_init(&session->rewind, session->replay.tick_ms);
+	rewind_capture(&session->rewind, &session->replay, game_state, player,
+		weapon_system);
+	return (0);
+}
+
+/**
+ * checkpoint_frame - Rewinds if BACKSPACE was pressed, autosaves if due
+ * @session: Session holding the checkpoint ring and save path
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ *
+ * Runs between frames, never in the middle of a tick. Each press goes
+ * back about REWIND_SECONDS and cuts the sounds still playing. A remote
+ * game is the server's to rewind.
+ */
+void checkpoint_frame(Session *session, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system)
+{
+	if (session->client)
+		return;
+	for (; session->rewinds > 0; session->rewinds--)
+		if (rewind_back(&session->rewind, &session->replay, game_state,
+			player, weapon_system) == 0)
+		{
+			session->saved_tick = game_state->tick;
+			audio_stop(&session->audio, SOUND_ALL);
+		}
+	if (session->save_path && session->autosave > 0 &&
+		game_state->tick - session->saved_tick >=
+		session->autosave * 1000u / session->replay.tick_ms)
+	{
+		save_file(session->save_path, game_state, player, weapon_system);
+		session->saved_tick = game_state->tick;
+	}
+}
+
+/**
+ * checkpoint_finish - Saves the game on exit if a save file was given
+ * @session: Session holding the save path
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ */
+void checkpoint_finish(Session *session, const GameState *game_state,
+		const Player *player, const WeaponSystem *weapon_system)
+{
+	if (session->client || !session->save_path ||
+		save_file(session->save_path, game_state, player, weapon_system) != 0)
+		return;
+	printf("Saved %s at tick %u\n", session->save_path,
+		(unsigned int)game_state->tick);
+}
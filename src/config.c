@@ -0,0 +1,206 @@
+#include "../inc/maze.h"
+#include "../inc/options.h"
+#include "../inc/resolution.h"
+#include <stddef.h>
+#include <errno.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * enum OptionType - How an option's text value is stored
+ * @OPT_STRING: const char * (kept, not copied)
+ * @OPT_INT: int
+ * @OPT_UINT: Uint32, any base strtoul accepts
+ * @OPT_FLOAT: float
+ * @OPT_DOUBLE: double
+ */
+enum OptionType
+{
+	OPT_STRING,
+	OPT_INT,
+	OPT_UINT,
+	OPT_FLOAT,
+	OPT_DOUBLE
+};
+
+/**
+ * struct OptionSpec - Maps an option name to a field of Options
+ * @name: Name used as "--name" and in the config file
+ * @type: Field type
+ * @offset: Field offset within Options
+ * @min: Smallest value accepted, unused for strings
+ * @max: Largest value accepted, unused for strings
+ */
+struct OptionSpec
+{
+	const char *name;
+	enum OptionType type;
+	size_t offset;
+	double min;
+	double max;
+};
+
+static const struct OptionSpec option_specs[] = {
+	{"capture", OPT_STRING, offsetof(Options, capture_path), 0, 0},
+	{"seed", OPT_UINT, offsetof(Options, seed), 0, 0xFFFFFFFFu},
+	{"record", OPT_STRING, offsetof(Options, record_path), 0, 0},
+	{"replay", OPT_STRING, offsetof(Options, replay_path), 0, 0},
+	{"golden-check", OPT_STRING, offsetof(Options, golden_dir), 0, 0},
+	{"golden-write", OPT_STRING, offsetof(Options, golden_dir), 0, 0},
+	{"budget-scale", OPT_DOUBLE, offsetof(Options, budget_scale), 0.01, 1000},
+	{"bench-engines", OPT_STRING, offsetof(Options, bench_engines), 0, 0},
+	{"target-ms", OPT_DOUBLE, offsetof(Options, target_ms), 0, 1000},
+	{"scale", OPT_FLOAT, offsetof(Options, scale), SCALE_MIN, 1},
+	{"window-width", OPT_INT, offsetof(Options, window_width), 1, 16384},
+	{"window-height", OPT_INT, offsetof(Options, window_height), 1, 16384},
+	{"fov", OPT_FLOAT, offsetof(Options, fov), 1, 179},
+	{"rays", OPT_INT, offsetof(Options, rays), 0, 16384},
+	{"max-depth", OPT_FLOAT, offsetof(Options, max_depth), 0.5, 64},
+	{"threads", OPT_INT, offsetof(Options, threads), 0, JOBS_MAX_THREADS},
+	{"vsync", OPT_INT, offsetof(Options, vsync), 0, 1},
+	{"tick-rate", OPT_INT, offsetof(Options, tick_rate), 1, 1000},
+	{"fog", OPT_UINT, offsetof(Options, fog), 0, 0xFFFFFF},
+	{"latency", OPT_INT, offsetof(Options, latency), 0, 1},
+	{"bench-entities", OPT_INT, offsetof(Options, bench_entities), 0, 1 << 24},
+	{"bench-particles", OPT_INT, offsetof(Options, bench_particles), 0,
+		1 << 24},
+	{"connect", OPT_STRING, offsetof(Options, connect), 0, 0},
+	{"load", OPT_STRING, offsetof(Options, load_path), 0, 0},
+	{"save", OPT_STRING, offsetof(Options, save_path), 0, 0},
+	{"autosave", OPT_INT, offsetof(Options, autosave), 0, 86400},
+	{"volume", OPT_INT, offsetof(Options, volume), 0, 100},
+	{"fixed", OPT_INT, offsetof(Options, fixed), 0, 1},
+	{"transpose", OPT_INT, offsetof(Options, transpose), 0, 1}
+};
+
+/**
+ * parse_number - Reads an option's whole text value as a number
+ * @value: Text value
+ * @type: OPT_INT, OPT_UINT, OPT_FLOAT or OPT_DOUBLE
+ * @number: Receives the value
+ * Return: 0 on success, -1 if the text is not entirely a number of the
+ * type or overflows it
+ */
+static int parse_number(const char *value, enum OptionType type,
+		double *number)
+{
+	char *end;
+
+	/* strtoul() would quietly wrap a negative number around */
+	if (type == OPT_UINT && strchr(value, '-'))
+		return (-1);
+	errno = 0;
+	if (type == OPT_INT)
+		*number = (double)strtol(value, &end, 10);
+	else if (type == OPT_UINT)
+		*number = (double)strtoul(value, &end, 0);
+	else
+		*number = strtod(value, &end);
+	return (end == value || *end != '\0' || errno == ERANGE ? -1 : 0);
+}
+
+/**
+ * set_option - Sets one option from its text value
+ * @options: Options to modify
+ * @name: Option name without the leading "--"
+ * @value: Text value; strings are stored by pointer
+ * Return: 0 on success, -1 if the name is unknown, -2 if the value is not
+ * a number of the option's type or is outside its range
+ */
+int set_option(Options *options, const char *name, const char *value)
+{
+	const struct OptionSpec *spec;
+	char *field;
+	double number = 0;
+	size_t i, count = sizeof(option_specs) / sizeof(option_specs[0]);
+
+	for (i = 0; i < count && strcmp(option_specs[i].name, name) != 0; i++)
+		;
+	if (i == count)
+		return (-1);
+	spec = &option_specs[i];
+	field = (char *)options + spec->offset;
+	/* Written as !(in range) so NaN is rejected too */
+	if (spec->type != OPT_STRING && (parse_number(value, spec->type,
+		&number) != 0 || !(number >= spec->min && number <= spec->max)))
+		return (-2);
+	if (spec->type == OPT_STRING)
+		*(const char **)field = value;
+	else if (spec->type == OPT_INT)
+		*(int *)field = (int)number;
+	else if (spec->type == OPT_UINT)
+		*(Uint32 *)field = (Uint32)number;
+	else if (spec->type == OPT_FLOAT)
+		*(float *)field = (float)number;
+	else
+		*(double *)field = number;
+	if (strcmp(name, "golden-check") == 0 || strcmp(name, "golden-write") == 0)
+		options->golden_write = name[7] == 'w';
+	return (0);
+}
+
+/**
+ * trim - Strips leading and trailing whitespace in place
+ * @text: String to trim
+ * Return: Pointer to the first non-space character
+ */
+static char *trim(char *text)
+{
+	char *end;
+
+	while (isspace((unsigned char)*text))
+		text++;
+	end = text + strlen(text);
+	while (end > text && isspace((unsigned char)end[-1]))
+		*--end = '\0';
+	return (text);
+}
+
+/**
+ * load_config - Applies "name = value" lines from a config file
+ * @options: Options to modify
+ * @path: Config file path
+ * @required: 1 if a missing file is an error
+ * Return: 0 on success, -1 on a missing required file or a bad line
+ *
+ * Blank lines and anything after a '#' are ignored. String values are
+ * copied, since the options keep pointers to them.
+ */
+int load_config(Options *options, const char *path, int required)
+{
+	FILE *file = fopen(path, "r");
+	char line[512], *key, *eq, *value, *comment;
+	int number = 0, status = 0, result;
+
+	if (!file)
+	{
+		if (required)
+			printf("Cannot open config %s\n", path);
+		return (required ? -1 : 0);
+	}
+	while (fgets(line, sizeof(line), file))
+	{
+		number++;
+		comment = strchr(line, '#');
+		if (comment)
+			*comment = '\0';
+		key = trim(line);
+		if (*key == '\0')
+			continue;
+		eq = strchr(key, '=');
+		value = eq ? strdup(trim(eq + 1)) : NULL;
+		if (eq)
+			*eq = '\0';
+		key = trim(key);
+		result = value ? set_option(options, key, value) : -1;
+		if (result != 0)
+		{
+			printf("%s:%d: %s \"%s\"\n", path, number, result == -2 ?
+				"invalid value for setting" : "unknown setting", key);
+			free(value);
+			status = -1;
+		}
+	}
+	fclose(file);
+	return (status);
+}
@@ -0,0 +1,106 @@
+#include "../inc/effects.h"
+
+#define CUE_GAP 8 /* Ticks between two looks that still count as play */
+
+/* Particle bursts, indices into cue_bursts */
+#define BURST_MUZZLE 0 /* Sparks thrown forward from the gun */
+#define BURST_IMPACT 1 /* Sparks where a bullet stopped */
+#define BURST_HIT 2    /* Blood from a hurt enemy */
+#define BURST_DEATH 3  /* Blood and embers from a dying enemy */
+
+static const Burst cue_bursts[] = {
+	{0, 0, 0.4f, 0, 0, 1.5f, 0.15f, 0xFFFFC060, 24},
+	{0, 0, 0.5f, 0, 0, 1.2f, 0.35f, 0xFFFFE0A0, 16},
+	{0, 0, 0.5f, 0, 0, 1.0f, 0.5f, 0xFFC01010, 48},
+	{0, 0, 0.4f, 0, 0, 2.0f, 1.0f, 0xFFFF4020, 240}
+};
+
+/**
+ * emit_cue - Throws one of the cue bursts out from a point
+ * @particles: Particle system
+ * @burst: BURST_* number
+ * @x: X of the point
+ * @y: Y of the point
+ */
+static void emit_cue(Particles *particles, int burst, float x, float y)
+{
+	Burst at = cue_bursts[burst];
+
+	at.x = x;
+	at.y = y;
+	particles_emit(particles, &at);
+}
+
+/**
+ * play_cues - Plays the sounds and effects of what happened since the
+ * last look
+ * @cues: What the game last looked like
+ * @tick: Tick the game is at
+ * @weapon_system: Enemies, shots, bullets and attacks to look at
+ * @player: Player hearing and seeing them
+ * @audio: Audio output
+ * @particles: Particle system the effects go into
+ *
+ * The simulation makes no sound or particles itself, so replays, saves
+ * and the server stay as they are; the game compares each tick with the
+ * one before. Shots, hits, attacks and deaths each play from where they
+ * happened, and bullets that stop short of their time out spark just
+ * in front of where they stopped. After a jump, as from a rewind or a
+ * load, the state is only taken in and the particles of the old
+ * timeline are dropped.
+ */
+void play_cues(Cues *cues, Uint32 tick, const WeaponSystem *weapon_system,
+		const Player *player, Audio *audio, Particles *particles)
+{
+	const Enemy *enemy;
+	const Bullet *bullet;
+	Burst muzzle = cue_bursts[BURST_MUZZLE];
+	int i, playing = tick > cues->tick && tick - cues->tick <= CUE_GAP;
+
+	if (!playing && tick != cues->tick && particles->count > 0)
+	{
+		particles->count = 0;
+		particles->version++;
+	}
+	if (playing && weapon_system->last_shot_time > cues->last_shot_time)
+	{
+		audio_play(audio, SOUND_SHOT, player->x, player->y, player);
+		muzzle.vx = cosf(player->angle) * 2.0f;
+		muzzle.vy = sinf(player->angle) * 2.0f;
+		muzzle.x = player->x + muzzle.vx * 0.1f;
+		muzzle.y = player->y + muzzle.vy * 0.1f;
+		particles_emit(particles, &muzzle);
+	}
+	for (i = 0; i < MAX_ENEMIES; i++)
+	{
+		enemy = &weapon_system->enemies[i];
+		if (playing && cues->alive[i] && !enemy->alive)
+		{
+			audio_play(audio, SOUND_DEATH, enemy->x, enemy->y, player);
+			emit_cue(particles, BURST_DEATH, enemy->x, enemy->y);
+		}
+		else if (playing && cues->alive[i] && enemy->health < cues->health[i])
+		{
+			audio_play(audio, SOUND_HIT, enemy->x, enemy->y, player);
+			emit_cue(particles, BURST_HIT, enemy->x, enemy->y);
+		}
+		if (playing && enemy->alive &&
+			enemy->last_attack > cues->last_attack[i])
+			audio_play(audio, SOUND_ATTACK, enemy->x, enemy->y, player);
+		cues->alive[i] = enemy->alive;
+		cues->health[i] = enemy->health;
+		cues->last_attack[i] = enemy->last_attack;
+	}
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		bullet = &weapon_system->bullets[i];
+		/* Bullets time out after 3 seconds in flight without hitting */
+		if (playing && cues->active[i] && !bullet->active &&
+			weapon_system->time - bullet->created <= 3000)
+			emit_cue(particles, BURST_IMPACT, bullet->x - bullet->dx * 0.05f,
+				bullet->y - bullet->dy * 0.05f);
+		cues->active[i] = bullet->active;
+	}
+	cues->tick = tick;
+	cues->last_shot_time = weapon_system->last_shot_time;
+}
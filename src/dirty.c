@@ -0,0 +1,62 @@
+#include "../inc/maze.h"
+
+/**
+ * world_key - Hashes everything the 3D view is rendered from
+ * @fb: Framebuffer (its render size)
+ * @view: Projection settings
+ * @player: Camera pose
+ * @lightmap: Lightmap, or NULL
+ * Return: Key that changes whenever the cast view would
+ */
+Uint32 world_key(const Framebuffer *fb, const View *view,
+		const Player *player, const Lightmap *lightmap)
+{
+	Uint32 hash = 2166136261u;
+
+	hash = hash_bytes(hash, &fb->width, sizeof(fb->width));
+	hash = hash_bytes(hash, &fb->height, sizeof(fb->height));
+	hash = hash_bytes(hash, &view->fov, sizeof(view->fov));
+	hash = hash_bytes(hash, &view->max_depth, sizeof(view->max_depth));
+	hash = hash_bytes(hash, &player->x, sizeof(player->x));
+	hash = hash_bytes(hash, &player->y, sizeof(player->y));
+	hash = hash_bytes(hash, &player->angle, sizeof(player->angle));
+	hash = hash_bytes(hash, door_open, sizeof(door_open));
+	if (lightmap)
+		hash = hash_bytes(hash, &lightmap->version, sizeof(lightmap->version));
+	return (hash);
+}
+
+/**
+ * frame_key - Hashes the 3D view key and everything drawn over it
+ * @renderer: SDL renderer (its output size)
+ * @world: Key from world_key()
+ * @game_state: Minimap toggle, zoom and the buttons the weapon sprite shows
+ * @weapon_system: Enemies, bullets and HUD values
+ * @stats: Frame statistics shown on the HUD
+ * Return: Key that changes whenever the presented frame would
+ */
+Uint32 frame_key(SDL_Renderer *renderer, Uint32 world,
+		const GameState *game_state, const WeaponSystem *weapon_system,
+		const FrameStats *stats)
+{
+	Uint32 hash = world, animation = (weapon_system->time / 200) % 2;
+	int size[2];
+
+	SDL_GetRendererOutputSize(renderer, &size[0], &size[1]);
+	hash = hash_bytes(hash, size, sizeof(size));
+	hash = hash_bytes(hash, &game_state->show_minimap, sizeof(int));
+	hash = hash_bytes(hash, &game_state->minimap_span, sizeof(int));
+	hash = hash_bytes(hash, &game_state->input, sizeof(game_state->input));
+	hash = hash_bytes(hash, weapon_system->enemies,
+		sizeof(weapon_system->enemies));
+	hash = hash_bytes(hash, weapon_system->bullets,
+		sizeof(weapon_system->bullets));
+	hash = hash_bytes(hash, &weapon_system->score, sizeof(int));
+	hash = hash_bytes(hash, &weapon_system->player_health, sizeof(int));
+	hash = hash_bytes(hash, &animation, sizeof(animation));
+	hash = hash_bytes(hash, &stats->fps, sizeof(stats->fps));
+	hash = hash_bytes(hash, &stats->average_ms, sizeof(stats->average_ms));
+	hash = hash_bytes(hash, &stats->worst_ms, sizeof(stats->worst_ms));
+	hash = hash_bytes(hash, &stats->latency_ms, sizeof(stats->latency_ms));
+	return (hash);
+}
@@ -0,0 +1,224 @@
+#include "../inc/maze.h"
+#include "../inc/weapon_sprites.h"
+#include <string.h>
+
+#define BENCH_TICKS 100 /* Ticks timed per thread count */
+#define FAR_TICKS 125     /* Ticks far enemies walk for in the speed check */
+#define FAR_START_MS 1000 /* Simulation time the speed check starts at */
+#define FAR_TOLERANCE 0.01 /* Relative speed difference the check allows */
+
+/**
+ * bench_spawn - Brings dead enemies and spent bullets back
+ * @update: Entity update whose arrays are refilled
+ * @rng: Random number generator
+ *
+ * Keeps the entity count steady so every tick costs about the same.
+ */
+static void bench_spawn(EntityUpdate *update, Rng *rng)
+{
+	int i, x, y;
+
+	for (i = 0; i < update->enemy_total + update->bullet_total; i++)
+	{
+		if (i < update->enemy_total ? update->enemies[i].alive :
+			update->bullets[i - update->enemy_total].active)
+			continue;
+		do {
+			x = rng_next(rng) % 15;
+			y = rng_next(rng) % 15;
+		} while (maze[y][x] != 0);
+		if (i < update->enemy_total)
+		{
+			memset(&update->enemies[i], 0, sizeof(Enemy));
+			update->enemies[i].x = x + rng_float(rng);
+			update->enemies[i].y = y + rng_float(rng);
+			update->enemies[i].alive = 1;
+			update->enemies[i].health = 100.0f;
+			update->enemies[i].speed = 0.03f + rng_float(rng) * 0.02f;
+			(*update->enemy_count)++;
+			continue;
+		}
+		update->bullets[i - update->enemy_total] = (Bullet){x + 0.5f,
+			y + 0.5f, cosf(i), sinf(i), 1, update->time};
+	}
+}
+
+/**
+ * bench_run - Times BENCH_TICKS entity updates on some number of threads
+ * @update: Entity update; its arrays hold the world to start from
+ * @threads: Threads to run the updates on
+ * @ms: Receives the average milliseconds per tick
+ * @thinking: Receives the average enemies whose AI ran per tick
+ * Return: Hash of the final state
+ */
+static Uint32 bench_run(EntityUpdate *update, int threads, double *ms,
+		double *thinking)
+{
+	JobPool pool;
+	Rng rng;
+	Uint64 start, spent = 0;
+	Uint32 hash = 2166136261u;
+	long due = 0;
+	int tick;
+
+	rng_seed(&rng, 1);
+	job_pool_init(&pool, threads);
+	for (tick = 0; tick < BENCH_TICKS; tick++)
+	{
+		update->time = tick * TICK_MS + 5000;
+		bench_spawn(update, &rng);
+		start = SDL_GetPerformanceCounter();
+		entities_update_bullets(update, &pool);
+		due += entities_update_enemies(update, &pool);
+		spent += SDL_GetPerformanceCounter() - start;
+	}
+	job_pool_destroy(&pool);
+	*ms = spent * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_TICKS;
+	*thinking = (double)due / BENCH_TICKS;
+	hash = hash_bytes(hash, update->enemies, sizeof(Enemy) *
+		update->enemy_total);
+	hash = hash_bytes(hash, update->bullets, sizeof(Bullet) *
+		update->bullet_total);
+	hash = hash_bytes(hash, update->score, sizeof(int));
+	hash = hash_bytes(hash, update->enemy_count, sizeof(int));
+	return (hash_bytes(hash, update->player_health, sizeof(int)));
+}
+
+/**
+ * bench_update - Allocates a world of enemies and bullets
+ * @update: Receives the arrays; all other fields are set up too
+ * @count: Enemies, and bullets, to create
+ * @player: Player the enemies chase
+ * @pvs: Visibility sets of the maze
+ * @totals: Score, enemy count, player health and AI cursor
+ * Return: 0 on success, -1 on allocation failure
+ */
+static int bench_update(EntityUpdate *update, int count,
+		const Player *player, const Pvs *pvs, int *totals)
+{
+	memset(update, 0, sizeof(*update));
+	update->enemies = calloc(count, sizeof(Enemy));
+	update->bullets = calloc(count, sizeof(Bullet));
+	update->hits = calloc(count, sizeof(BulletHit));
+	update->events = calloc(count, sizeof(Uint8));
+	update->due = calloc(count, sizeof(int));
+	update->tiers = calloc(count, sizeof(Uint8));
+	update->grid = calloc(1, sizeof(EnemyGrid));
+	if (update->grid)
+		update->grid->enemies = calloc(4 * (size_t)count, sizeof(int));
+	update->enemy_total = update->bullet_total = count;
+	update->player = player;
+	update->pvs = pvs;
+	update->tick_ms = TICK_MS;
+	update->score = &totals[0];
+	update->enemy_count = &totals[1];
+	update->player_health = &totals[2];
+	update->ai_cursor = &totals[3];
+	totals[0] = totals[1] = totals[2] = totals[3] = 0;
+	return (update->enemies && update->bullets && update->hits &&
+		update->events && update->due && update->tiers && update->grid &&
+		update->grid->enemies ? 0 : -1);
+}
+
+/**
+ * far_speed - Measures how fast far enemies travel among @count enemies
+ * @count: Enemies in the world
+ * @player: Player, far from the enemies
+ * @pvs: Visibility sets of the maze
+ * Return: Average cells per second, or -1 on allocation failure
+ *
+ * Every enemy walks the open bottom corridor towards its far end. Each
+ * one's distance is divided by the time up to its last update, so the
+ * speed does not depend on where its slice fell in the last tick.
+ */
+static double far_speed(int count, const Player *player, const Pvs *pvs)
+{
+	EntityUpdate update = {0};
+	double cells = -1;
+	int i, tick, cursor = 0, health = 0;
+
+	update.enemies = calloc(count, sizeof(Enemy));
+	update.events = calloc(count, sizeof(Uint8));
+	update.due = calloc(count, sizeof(int));
+	update.tiers = calloc(count, sizeof(Uint8));
+	update.enemy_total = count;
+	update.player = player;
+	update.pvs = pvs;
+	update.tick_ms = TICK_MS;
+	update.ai_cursor = &cursor;
+	update.player_health = &health;
+	if (update.enemies && update.events && update.due && update.tiers)
+	{
+		for (i = 0; i < count; i++)
+			update.enemies[i] = (Enemy){1.5f, 13.5f, 1, 100.0f, 0.04f, 0, 0,
+				0, 0, FAR_START_MS, ENEMY_GOTO, 13.5f, 13.5f};
+		for (tick = 1; tick <= FAR_TICKS; tick++)
+		{
+			update.time = FAR_START_MS + tick * TICK_MS;
+			entities_update_enemies(&update, NULL);
+		}
+		for (i = 0, cells = 0; i < count; i++)
+			cells += (update.enemies[i].x - 1.5f) * 1000.0 /
+				(update.enemies[i].thought - FAR_START_MS) / count;
+	}
+	free(update.enemies);
+	free(update.events);
+	free(update.due);
+	free(update.tiers);
+	return (cells);
+}
+
+/**
+ * run_entity_bench - Measures how entity updates scale from 1 to 16 threads
+ * @count: Enemies, and bullets, in the benchmark world
+ * Return: 0 if every thread count gave the same state and far enemies
+ * moved as fast among @count enemies as among AI_SLICE, 1 otherwise
+ */
+int run_entity_bench(int count)
+{
+	static Pvs pvs;
+	const int threads[] = {1, 2, 4, 8, 12, 16};
+	EntityUpdate update;
+	Player player = {7.5f, 7.5f, 0, 1, 0, NULL};
+	Uint32 hash, first = 0;
+	double ms, thinking, base = 0, slow, fast;
+	int i, totals[4], failed = 0, speed_ok;
+
+	doors_reset();
+	pvs_build(&pvs, maze);
+	printf("Entity update, %d enemies and %d bullets, %d ticks, %d CPUs\n",
+		count, count, BENCH_TICKS, SDL_GetCPUCount());
+	for (i = 0; i < (int)(sizeof(threads) / sizeof(threads[0])); i++)
+	{
+		if (bench_update(&update, count, &player, &pvs, totals) != 0)
+		{
+			printf("Out of memory\n");
+			failed = 1;
+		}
+		else
+		{
+			hash = bench_run(&update, threads[i], &ms, &thinking);
+			first = i ? first : hash;
+			base = i ? base : ms;
+			failed |= hash != first;
+			printf("%2d threads: %8.3f ms/tick  %5.2fx  %6.1f AI/tick"
+				"  state %08x%s\n", threads[i], ms, base / ms, thinking,
+				hash, hash == first ? "" : "  MISMATCH");
+		}
+		free(update.enemies);
+		free(update.bullets);
+		free(update.hits);
+		free(update.events);
+		free(update.due);
+		free(update.tiers);
+		if (update.grid)
+			free(update.grid->enemies);
+		free(update.grid);
+	}
+	slow = far_speed(AI_SLICE, &player, &pvs);
+	fast = far_speed(count, &player, &pvs);
+	speed_ok = slow > 0 && fast > 0 && fabs(fast - slow) <= FAR_TOLERANCE * slow;
+	printf("Far enemy speed: %.3f cells/s with %d enemies, %.3f with %d%s\n",
+		slow, AI_SLICE, fast, count, speed_ok ? "" : "  MISMATCH");
+	return (failed || !speed_ok);
+}
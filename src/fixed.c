@@ -0,0 +1,67 @@
+#include "../inc/fixed.h"
+
+FixedTables fixed_tables;
+
+/**
+ * fixed_tables_init - Builds the fixed-point renderer's tables once
+ *
+ * Only called from the main thread, before any column job starts.
+ */
+void fixed_tables_init(void)
+{
+	double angle, inverse;
+	int i;
+
+	if (fixed_tables.ready)
+		return;
+	for (i = 0; i < FIX_TURN; i++)
+	{
+		angle = 2.0 * M_PI * i / FIX_TURN;
+		fixed_tables.cos[i] = (Sint32)lround(cos(angle) *
+			(1 << FIX_TRIG_SHIFT));
+		inverse = fabs(FIX_ONE / cos(angle));
+		fixed_tables.inv_cos[i] = inverse < FIX_FAR ? (Fixed)lround(inverse) :
+			FIX_FAR;
+	}
+	for (i = 0; i < FIX_LIGHT_STEPS; i++)
+		fixed_tables.light[i] = light_level((i + 0.5f) /
+			(1 << (FIX_SHIFT - FIX_LIGHT_SHIFT)));
+	fixed_tables.ready = 1;
+}
+
+/**
+ * fixed_lookup - Reads a per-angle table at a binary angle
+ * @table: fixed_tables.cos or fixed_tables.inv_cos
+ * @angle: Binary angle
+ * Return: Value interpolated between the two nearest entries
+ *
+ * Rounding to the nearest entry alone would turn rays by up to half a
+ * step, which shifts far walls by a good part of a texel; interpolating
+ * keeps them on the same texels as the float renderer.
+ */
+Sint32 fixed_lookup(const Sint32 *table, Uint32 angle)
+{
+	Uint32 index = angle >> (32 - FIX_TURN_BITS);
+	Sint32 low = table[index], high = table[(index + 1) & (FIX_TURN - 1)];
+	Fixed fraction = (angle >> (32 - FIX_TURN_BITS - FIX_SHIFT)) &
+		(FIX_ONE - 1);
+
+	return (low + FIX_MUL(high - low, fraction));
+}
+
+/**
+ * fixed_light - Looks up the lightmap at a fixed-point position
+ * @lightmap: Lightmap, or NULL
+ * @x: X in the maze
+ * @y: Y in the maze
+ * Return: Light level offset of the cell, 0 outside the maze
+ */
+int fixed_light(const Lightmap *lightmap, Fixed x, Fixed y)
+{
+	int cx = x >> FIX_SHIFT, cy = y >> FIX_SHIFT;
+
+	if (!lightmap || x < 0 || y < 0 || cx >= LIGHTMAP_SIZE ||
+		cy >= LIGHTMAP_SIZE)
+		return (0);
+	return (lightmap->level[cy][cx]);
+}
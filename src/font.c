@@ -0,0 +1,105 @@
+#include "../inc/text.h"
+
+/*
+ * 5x7 glyphs from space (32) to '_' (95), one byte per row, top row
+ * first; bit 4 is the leftmost pixel.
+ */
+static const Uint8 font_glyphs[FONT_GLYPHS][FONT_HEIGHT] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /* space */
+	{0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, /* ! */
+	{0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, /* " */
+	{0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, /* # */
+	{0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, /* $ */
+	{0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, /* % */
+	{0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, /* & */
+	{0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, /* quote */
+	{0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, /* ( */
+	{0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, /* ) */
+	{0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, /* * */
+	{0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, /* + */
+	{0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, /* , */
+	{0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, /* - */
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, /* . */
+	{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, /* / */
+	{0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, /* 0 */
+	{0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, /* 1 */
+	{0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, /* 2 */
+	{0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, /* 3 */
+	{0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, /* 4 */
+	{0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, /* 5 */
+	{0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, /* 6 */
+	{0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, /* 7 */
+	{0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, /* 8 */
+	{0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, /* 9 */
+	{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, /* : */
+	{0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, /* ; */
+	{0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, /* < */
+	{0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, /* = */
+	{0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, /* > */
+	{0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, /* ? */
+	{0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, /* @ */
+	{0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, /* A */
+	{0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, /* B */
+	{0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, /* C */
+	{0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, /* D */
+	{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, /* E */
+	{0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, /* F */
+	{0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, /* G */
+	{0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, /* H */
+	{0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, /* I */
+	{0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, /* J */
+	{0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, /* K */
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, /* L */
+	{0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, /* M */
+	{0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, /* N */
+	{0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, /* O */
+	{0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, /* P */
+	{0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, /* Q */
+	{0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, /* R */
+	{0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, /* S */
+	{0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, /* T */
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, /* U */
+	{0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, /* V */
+	{0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, /* W */
+	{0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, /* X */
+	{0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, /* Y */
+	{0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, /* Z */
+	{0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, /* [ */
+	{0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, /* backslash */
+	{0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, /* ] */
+	{0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, /* ^ */
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, /* _ */
+};
+
+/**
+ * font_atlas - Builds the glyph atlas texture from the embedded font
+ * @renderer: SDL renderer the atlas is drawn with
+ * Return: Texture of FONT_ATLAS_W x FONT_ATLAS_H, or NULL on failure
+ *
+ * Set pixels are opaque white so the vertex color tints the text; the
+ * rest is transparent.
+ */
+SDL_Texture *font_atlas(SDL_Renderer *renderer)
+{
+	Uint32 pixels[FONT_ATLAS_W * FONT_ATLAS_H] = {0};
+	SDL_Texture *atlas;
+	int glyph, row, col, x, y;
+
+	for (glyph = 0; glyph < FONT_GLYPHS; glyph++)
+	{
+		x = glyph % FONT_ATLAS_COLS * FONT_CELL_W;
+		y = glyph / FONT_ATLAS_COLS * FONT_CELL_H;
+		for (row = 0; row < FONT_HEIGHT; row++)
+			for (col = 0; col < FONT_WIDTH; col++)
+				if (font_glyphs[glyph][row] & (0x10 >> col))
+					pixels[(y + row) * FONT_ATLAS_W + x + col] = 0xFFFFFFFF;
+	}
+	atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+		SDL_TEXTUREACCESS_STATIC, FONT_ATLAS_W, FONT_ATLAS_H);
+	if (!atlas)
+		return (NULL);
+	SDL_UpdateTexture(atlas, NULL, pixels, FONT_ATLAS_W * sizeof(Uint32));
+	SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+	SDL_SetTextureScaleMode(atlas, SDL_ScaleModeNearest);
+	return (atlas);
+}
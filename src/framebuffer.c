@@ -0,0 +1,117 @@
+#include "../inc/maze.h"
+
+/**
+ * init_framebuffer - Allocates the CPU framebuffer and its texture
+ * @fb: Framebuffer to initialize
+ * @renderer: SDL renderer that presents the framebuffer (may be NULL for
+ * headless rendering)
+ * @width: Largest render width in pixels
+ * @height: Largest render height in pixels
+ * Return: 0 on success, -1 on failure
+ */
+int init_framebuffer(Framebuffer *fb, SDL_Renderer *renderer,
+			int width, int height)
+{
+	fb->width = fb->max_width = width;
+	fb->height = fb->max_height = height;
+	fb->pitch = width;
+	fb->texture = NULL;
+	fb->valid = 0;
+	fb->backing = malloc(sizeof(Uint32) * width * height);
+	fb->pixels = fb->backing;
+	fb->depth = malloc(sizeof(float) * width);
+	/* Whole 4x4 blocks are transposed, so both sides round up to 4 */
+	fb->column_pitch = (height + 3) & ~3;
+	fb->columns = malloc(sizeof(Uint32) * fb->column_pitch *
+		((width + 3) & ~3));
+	fb->transposed = 0;
+	if (!fb->backing || !fb->depth || !fb->columns)
+	{
+		cleanup_framebuffer(fb);
+		return (-1);
+	}
+
+	if (renderer)
+	{
+		/* Smooth the upscale when rendering below window resolution */
+		SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+		fb->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+				SDL_TEXTUREACCESS_STREAMING, width, height);
+		if (!fb->texture)
+		{
+			printf("Framebuffer texture creation failed: %s\n",
+				SDL_GetError());
+			cleanup_framebuffer(fb);
+			return (-1);
+		}
+	}
+	clear_framebuffer(fb);
+	return (0);
+}
+
+/**
+ * clear_framebuffer - Fills the rendered area with opaque black
+ * @fb: Framebuffer to clear
+ *
+ * Clears the buffer the 3D view is cast into, a row or, while
+ * transposed, a column at a time.
+ */
+void clear_framebuffer(Framebuffer *fb)
+{
+	Uint32 *line, *p;
+	int i, lines = fb->transposed ? fb->width : fb->height;
+	int length = fb->transposed ? fb->height : fb->width;
+
+	for (i = 0; i < lines; i++)
+	{
+		line = fb->transposed ? fb->columns + i * fb->column_pitch :
+			fb->pixels + i * fb->pitch;
+		for (p = line; p < line + length; p++)
+			*p = FB_RGB(0, 0, 0);
+	}
+}
+
+/**
+ * upload_framebuffer - Copies the rendered area into the texture
+ * @fb: Framebuffer that was rendered
+ */
+void upload_framebuffer(Framebuffer *fb)
+{
+	SDL_Rect area = {0, 0, fb->width, fb->height};
+
+	SDL_UpdateTexture(fb->texture, &area, fb->pixels,
+		fb->pitch * (int)sizeof(Uint32));
+}
+
+/**
+ * present_framebuffer - Draws the last uploaded frame
+ * @renderer: SDL renderer
+ * @fb: Framebuffer to present
+ *
+ * Stretches the rendered area over the whole render target, so a reduced
+ * render size is upscaled. Overlays are drawn by the caller afterwards.
+ */
+void present_framebuffer(SDL_Renderer *renderer, Framebuffer *fb)
+{
+	SDL_Rect area = {0, 0, fb->width, fb->height};
+
+	SDL_RenderCopy(renderer, fb->texture, &area, NULL);
+}
+
+/**
+ * cleanup_framebuffer - Frees framebuffer memory and texture
+ * @fb: Framebuffer to free
+ */
+void cleanup_framebuffer(Framebuffer *fb)
+{
+	if (fb->texture)
+		SDL_DestroyTexture(fb->texture);
+	free(fb->backing);
+	free(fb->depth);
+	free(fb->columns);
+	fb->texture = NULL;
+	fb->backing = NULL;
+	fb->depth = NULL;
+	fb->columns = NULL;
+	fb->pixels = NULL;
+}
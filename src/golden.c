@@ -0,0 +1,197 @@
+#include "../inc/golden.h"
+#include <string.h>
+
+/* Camera poses covering corridors, junctions, a wall at point blank and
+ * the see-through cells: a grate, a low wall and a closed door */
+static const GoldenScene scenes[] = {
+	{"start", 1.5f, 1.5f, 0.0f, 12.0},
+	{"long_corridor", 1.5f, 2.5f, 1.5708f, 12.0},
+	{"point_blank", 1.5f, 1.5f, 3.1416f, 12.0},
+	{"bottom_hall", 1.5f, 13.5f, 0.0f, 12.0},
+	{"junction", 7.5f, 7.5f, 0.6f, 12.0},
+	{"grate", 10.5f, 7.5f, 4.4f, 12.0},
+	{"low_wall", 11.3f, 7.3f, 1.3f, 12.0},
+	{"door", 8.2f, 1.5f, 0.1f, 12.0}
+};
+
+/**
+ * render_scene - Renders a scene repeatedly and times the fastest run
+ * @rig: Headless renderer
+ * @scene: Scene to render
+ * Return: Fastest render time in milliseconds, including the transpose
+ * of a column-major frame
+ */
+static double render_scene(GoldenRig *rig, const GoldenScene *scene)
+{
+	Player player = {0};
+	Uint64 start, ticks, best = 0;
+	int i;
+
+	player.x = scene->x;
+	player.y = scene->y;
+	player.angle = scene->angle;
+	player.dx = cos(scene->angle);
+	player.dy = sin(scene->angle);
+	for (i = 0; i < GOLDEN_RUNS; i++)
+	{
+		start = SDL_GetPerformanceCounter();
+		clear_framebuffer(&rig->fb);
+		cast_rays(&rig->fb, &rig->view, &player, maze, &rig->textures,
+			&rig->lightmap);
+		resolve_framebuffer(&rig->fb);
+		ticks = SDL_GetPerformanceCounter() - start;
+		if (i == 0 || ticks < best)
+			best = ticks;
+	}
+	return (best * 1000.0 / SDL_GetPerformanceFrequency());
+}
+
+/**
+ * check_scene - Renders one scene and checks it against its golden
+ * @rig: Headless renderer
+ * @scene: Scene to check
+ * @dir: Golden image directory
+ * @budget_scale: Multiplier applied to the scene's frame-time budget
+ * Return: 0 if the scene passes, -1 otherwise
+ */
+static int check_scene(GoldenRig *rig, const GoldenScene *scene,
+		const char *dir, double budget_scale)
+{
+	char path[512];
+	double ms, diff, budget = scene->budget_ms * budget_scale;
+	int image_ok, time_ok;
+
+	ms = render_scene(rig, scene);
+	snprintf(path, sizeof(path), "%s/%s.png", dir, scene->name);
+	image_ok = golden_compare(&rig->fb, path, &diff) == 0;
+	time_ok = ms <= budget;
+	printf("%-16s diff %6.2f%%  %7.3f ms / %7.3f ms  %s\n", scene->name,
+		diff, ms, budget, image_ok && time_ok ? "ok" :
+		!image_ok ? "FAIL (image)" : "FAIL (budget)");
+	if (!image_ok)
+	{
+		/* Keep the mismatching frame next to the golden for inspection */
+		snprintf(path, sizeof(path), "%s/%s-actual.png", dir, scene->name);
+		golden_save(&rig->fb, path);
+	}
+	return (image_ok && time_ok ? 0 : -1);
+}
+
+/**
+ * run_golden - Renders the fixed scenes headlessly and checks or writes them
+ * @dir: Golden image directory
+ * @write: 1 to (re)write the golden images, 0 to check against them
+ * @budget_scale: Multiplier applied to every frame-time budget
+ * @fixed: 1 to render with the fixed-point renderer
+ * @transposed: 1 to render into the column-major buffer
+ * Return: 0 if every scene passed, 1 otherwise
+ *
+ * The goldens are float renders; the fixed-point renderer passes when it
+ * stays within the same tolerance of them.
+ */
+int run_golden(const char *dir, int write, double budget_scale, int fixed,
+		int transposed)
+{
+	GoldenRig rig;
+	char path[512];
+	int i, failed = 0, count = sizeof(scenes) / sizeof(scenes[0]);
+
+	if (golden_rig_init(&rig, fixed, transposed) != 0)
+	{
+		printf("Golden check initialization failed\n");
+		return (1);
+	}
+	for (i = 0; i < count; i++)
+	{
+		if (write)
+		{
+			render_scene(&rig, &scenes[i]);
+			snprintf(path, sizeof(path), "%s/%s.png", dir, scenes[i].name);
+			failed += golden_save(&rig.fb, path) != 0;
+		}
+		else
+			failed += check_scene(&rig, &scenes[i], dir, budget_scale) != 0;
+	}
+	printf("%d/%d scenes %s\n", count - failed, count,
+		write ? "written" : "passed");
+	golden_rig_cleanup(&rig);
+	return (failed != 0);
+}
+
+/**
+ * bench_scene - Times one scene with both renderers and both layouts
+ * @rig: Headless renderer
+ * @scene: Scene to render
+ * @dir: Golden image directory
+ * @totals: Running float, float columns, fixed and fixed columns totals
+ * @rows: Scratch for one row-major frame
+ * Return: 0 if the frames match the golden and each column-major frame
+ * matches its row-major one pixel for pixel, -1 otherwise
+ */
+static int bench_scene(GoldenRig *rig, const GoldenScene *scene,
+		const char *dir, double *totals, Uint32 *rows)
+{
+	char path[512];
+	double ms[4], diff;
+	size_t size = sizeof(Uint32) * rig->fb.pitch * rig->fb.height;
+	int mode, match = 1, same = 1;
+
+	snprintf(path, sizeof(path), "%s/%s.png", dir, scene->name);
+	for (mode = 0; mode < 4; mode++)
+	{
+		rig->view.fixed = mode / 2;
+		rig->fb.transposed = mode % 2;
+		ms[mode] = render_scene(rig, scene);
+		totals[mode] += ms[mode];
+		if (!rig->fb.transposed)
+			memcpy(rows, rig->fb.pixels, size);
+		else
+			same = same && memcmp(rows, rig->fb.pixels, size) == 0;
+		match = match && golden_compare(&rig->fb, path, &diff) == 0;
+	}
+	printf("%-16s %9.3f %9.3f %9.3f %9.3f %5.2f%%  %s\n", scene->name,
+		ms[0], ms[1], ms[2], ms[3], diff, !same ? "FAIL (layout)" :
+		!match ? "FAIL (image)" : "ok");
+	return (match && same ? 0 : -1);
+}
+
+/**
+ * run_engine_bench - Times the float and fixed-point renderers, casting
+ * into rows and into columns, on the golden scenes
+ * @dir: Golden image directory the frames are compared with
+ * Return: 0 if every frame matched, 1 otherwise
+ *
+ * Every renderer casts on the calling thread, so the times compare the
+ * arithmetic and memory access alone rather than how well each one
+ * spreads over cores. The column-major times include the transpose.
+ */
+int run_engine_bench(const char *dir)
+{
+	GoldenRig rig;
+	Uint32 *rows;
+	double totals[4] = {0};
+	int i, failed = 0, count = sizeof(scenes) / sizeof(scenes[0]);
+
+	if (golden_rig_init(&rig, 0, 0) != 0)
+	{
+		printf("Engine benchmark initialization failed\n");
+		return (1);
+	}
+	rows = malloc(sizeof(Uint32) * rig.fb.pitch * rig.fb.height);
+	if (!rows)
+	{
+		golden_rig_cleanup(&rig);
+		return (1);
+	}
+	printf("%-16s %9s %9s %9s %9s   diff\n", "Scene (ms)", "float",
+		"columns", "fixed", "columns");
+	for (i = 0; i < count; i++)
+		failed += bench_scene(&rig, &scenes[i], dir, totals, rows) != 0;
+	printf("%-16s %9.3f %9.3f %9.3f %9.3f\n", "total", totals[0],
+		totals[1], totals[2], totals[3]);
+	printf("Columns speedup: float %.2fx, fixed %.2fx\n",
+		totals[0] / totals[1], totals[2] / totals[3]);
+	free(rows);
+	golden_rig_cleanup(&rig);
+	return (failed != 0);
+}
@@ -0,0 +1,123 @@
+#include "../inc/golden.h"
+
+/**
+ * golden_save - Writes the framebuffer to a PNG file
+ * @fb: Rendered framebuffer
+ * @path: Output path
+ * Return: 0 on success, -1 on failure
+ */
+int golden_save(const Framebuffer *fb, const char *path)
+{
+	SDL_Surface *surface;
+	int status;
+
+	surface = SDL_CreateRGBSurfaceWithFormatFrom(fb->pixels, fb->width,
+		fb->height, 32, fb->pitch * (int)sizeof(Uint32),
+		SDL_PIXELFORMAT_ARGB8888);
+	if (!surface)
+		return (-1);
+	status = IMG_SavePNG(surface, path);
+	SDL_FreeSurface(surface);
+	if (status != 0)
+		printf("Cannot write %s: %s\n", path, IMG_GetError());
+	return (status);
+}
+
+/**
+ * count_differences - Counts pixels outside the channel tolerance
+ * @fb: Rendered framebuffer
+ * @golden: Golden image, ARGB8888 and the same size as @fb
+ * Return: Number of differing pixels
+ */
+static int count_differences(const Framebuffer *fb, SDL_Surface *golden)
+{
+	int x, y, shift, delta, count = 0;
+	Uint32 a, b;
+
+	for (y = 0; y < fb->height; y++)
+		for (x = 0; x < fb->width; x++)
+		{
+			a = fb->pixels[y * fb->pitch + x];
+			b = ((Uint32 *)((Uint8 *)golden->pixels +
+				y * golden->pitch))[x];
+			for (shift = 0; shift < 24; shift += 8)
+			{
+				delta = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+				if (delta > GOLDEN_CHANNEL_TOLERANCE ||
+					delta < -GOLDEN_CHANNEL_TOLERANCE)
+				{
+					count++;
+					break;
+				}
+			}
+		}
+	return (count);
+}
+
+/**
+ * golden_compare - Compares the framebuffer against a golden image
+ * @fb: Rendered framebuffer
+ * @path: Golden image path
+ * @diff: Receives the percentage of differing pixels
+ * Return: 0 if within tolerance, -1 if not or the image is missing
+ */
+int golden_compare(const Framebuffer *fb, const char *path, double *diff)
+{
+	SDL_Surface *loaded, *golden;
+	int count;
+
+	*diff = 100.0;
+	loaded = IMG_Load(path);
+	if (!loaded)
+	{
+		printf("Cannot load %s: %s\n", path, IMG_GetError());
+		return (-1);
+	}
+	golden = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+	SDL_FreeSurface(loaded);
+	if (!golden)
+		return (-1);
+	if (golden->w == fb->width && golden->h == fb->height)
+	{
+		SDL_LockSurface(golden);
+		count = count_differences(fb, golden);
+		SDL_UnlockSurface(golden);
+		*diff = 100.0 * count / (fb->width * fb->height);
+	}
+	SDL_FreeSurface(golden);
+	return (*diff <= GOLDEN_PIXEL_TOLERANCE ? 0 : -1);
+}
+
+/**
+ * golden_rig_init - Sets up the headless renderer the scenes are drawn with
+ * @rig: Rig to initialize
+ * @fixed: 1 to render with the fixed-point renderer
+ * @transposed: 1 to render into the column-major buffer
+ * Return: 0 on success, -1 on failure
+ */
+int golden_rig_init(GoldenRig *rig, int fixed, int transposed)
+{
+	if (init_textures(&rig->textures, FOG_COLOR) != 0)
+		return (-1);
+	if (init_framebuffer(&rig->fb, NULL, SCREEN_WIDTH, SCREEN_HEIGHT) != 0)
+	{
+		cleanup_textures(&rig->textures);
+		return (-1);
+	}
+	rig->fb.transposed = transposed;
+	view_init(&rig->view, FOV, MAX_DEPTH, NULL);
+	rig->view.fixed = fixed;
+	lightmap_bake(&rig->lightmap, maze);
+	return (0);
+}
+
+/**
+ * golden_rig_cleanup - Frees the headless renderer
+ * @rig: Rig to free
+ */
+void golden_rig_cleanup(GoldenRig *rig)
+{
+	view_cleanup(&rig->view);
+	cleanup_framebuffer(&rig->fb);
+	cleanup_textures(&rig->textures);
+}
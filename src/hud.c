@@ -0,0 +1,95 @@
+#include "../inc/maze.h"
+#include "../inc/hud.h"
+
+/**
+ * draw_health_bar - Draws the health bar in the bottom left corner
+ * @renderer: SDL renderer
+ * @health: Player health, 0 to 100
+ * @screen_h: Renderer output height
+ */
+static void draw_health_bar(SDL_Renderer *renderer, int health, int screen_h)
+{
+	SDL_Rect health_bg = {20, screen_h - 30, 200, 20};
+	SDL_Rect health_fill = {20, screen_h - 30, health * 2, 20};
+
+	SDL_SetRenderDrawColor(renderer, 100, 100, 100, 200);
+	SDL_RenderFillRect(renderer, &health_bg);
+
+	/* Color changes with health level */
+	if (health > 70)
+		SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+	else if (health > 30)
+		SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+	else
+		SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+
+	SDL_RenderFillRect(renderer, &health_fill);
+}
+
+/**
+ * draw_hud - Draws health, score and frame statistics
+ * @renderer: SDL renderer
+ * @text: Text batch the labels are queued in
+ * @weapon_system: Health and score
+ * @stats: Frame rate and render time, or NULL to hide them
+ *
+ * All labels go out in one text_flush(); the strings live on the stack.
+ */
+void draw_hud(SDL_Renderer *renderer, TextBatch *text,
+		const WeaponSystem *weapon_system, const FrameStats *stats)
+{
+	const SDL_Color white = {255, 255, 255, 255}, grey = {200, 200, 200, 255};
+	char line[64];
+	int screen_h;
+
+	SDL_GetRendererOutputSize(renderer, NULL, &screen_h);
+	draw_health_bar(renderer, weapon_system->player_health, screen_h);
+
+	snprintf(line, sizeof(line), "%d", weapon_system->player_health);
+	text_add(text, 230, screen_h - 27, 2, white, line);
+	snprintf(line, sizeof(line), "Score %d", weapon_system->score);
+	text_add(text, 20, screen_h - 58, 3, white, line);
+	if (stats)
+	{
+		snprintf(line, sizeof(line), "%d FPS  %.1f ms  max %.1f ms",
+			stats->fps, stats->average_ms, stats->worst_ms);
+		text_add(text, 10, 10, 2, grey, line);
+		if (stats->latency.samples)
+		{
+			snprintf(line, sizeof(line), "input p95 %d ms",
+				stats->latency_ms);
+			text_add(text, 10, 28, 2, grey, line);
+		}
+	}
+	text_flush(text, renderer);
+}
+
+/**
+ * frame_stats_add - Records the render time of one frame
+ * @stats: Frame statistics
+ * @ms: Time render_frame() took, in milliseconds
+ * @now: SDL_GetTicks() time
+ *
+ * Publishes the window's frame rate, average and worst render time once
+ * STATS_WINDOW_MS have passed, along with the input latency so far, then
+ * starts a new window.
+ */
+void frame_stats_add(FrameStats *stats, double ms, Uint32 now)
+{
+	Uint32 elapsed = now - stats->window_start;
+
+	stats->window_frames++;
+	stats->window_ms += ms;
+	if (ms > stats->window_worst)
+		stats->window_worst = ms;
+	if (elapsed < STATS_WINDOW_MS)
+		return;
+	stats->fps = (int)(stats->window_frames * 1000.0 / elapsed + 0.5);
+	stats->average_ms = stats->window_ms / stats->window_frames;
+	stats->worst_ms = stats->window_worst;
+	stats->latency_ms = latency_percentile(&stats->latency, 95);
+	stats->window_start = now;
+	stats->window_frames = 0;
+	stats->window_ms = 0;
+	stats->window_worst = 0;
+}
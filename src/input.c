@@ -0,0 +1,46 @@
+#include "../inc/input.h"
+
+/* Keys the game reads and the buttons they map to */
+static const struct
+{
+	SDL_Scancode scancode;
+	Uint8 button;
+} key_map[] = {
+	{SDL_SCANCODE_W, INPUT_FORWARD},
+	{SDL_SCANCODE_S, INPUT_BACK},
+	{SDL_SCANCODE_A, INPUT_STRAFE_LEFT},
+	{SDL_SCANCODE_D, INPUT_STRAFE_RIGHT},
+	{SDL_SCANCODE_LEFT, INPUT_TURN_LEFT},
+	{SDL_SCANCODE_RIGHT, INPUT_TURN_RIGHT},
+	{SDL_SCANCODE_SPACE, INPUT_FIRE}
+};
+
+/**
+ * input_button - Looks up the button a key controls
+ * @scancode: Key
+ * Return: INPUT_* flag, or 0 if the game does not use the key
+ */
+Uint8 input_button(SDL_Scancode scancode)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(key_map) / sizeof(key_map[0]); i++)
+		if (key_map[i].scancode == scancode)
+			return (key_map[i].button);
+	return (0);
+}
+
+/**
+ * input_from_keyboard - Samples the buttons of one tick from the keyboard
+ * @input: Receives the sampled input
+ * @keyboard: SDL keyboard state array
+ */
+void input_from_keyboard(Input *input, const Uint8 *keyboard)
+{
+	size_t i;
+
+	input->buttons = 0;
+	for (i = 0; i < sizeof(key_map) / sizeof(key_map[0]); i++)
+		if (keyboard[key_map[i].scancode])
+			input->buttons |= key_map[i].button;
+}
@@ -0,0 +1,96 @@
+#include "../inc/input.h"
+
+/**
+ * input_watch - SDL event watch that queues game key events
+ * @data: Input queue
+ * @event: Event SDL just received
+ * Return: Always 1 (the return value of a watch is ignored)
+ *
+ * Runs as events are pumped, before they reach SDL_PollEvent(), so even
+ * a press and release within one frame are both queued.
+ */
+static int input_watch(void *data, SDL_Event *event)
+{
+	InputQueue *queue = data;
+	InputEvent *slot;
+	Uint8 button;
+	int head;
+
+	if ((event->type != SDL_KEYDOWN && event->type != SDL_KEYUP) ||
+		event->key.repeat)
+		return (1);
+	button = input_button(event->key.keysym.scancode);
+	if (!button)
+		return (1);
+	head = SDL_AtomicGet(&queue->head);
+	if (head - SDL_AtomicGet(&queue->tail) == INPUT_QUEUE_SIZE)
+	{
+		SDL_AtomicSet(&queue->overflow, 1);
+		return (1);
+	}
+	slot = &queue->events[head & (INPUT_QUEUE_SIZE - 1)];
+	slot->timestamp = event->common.timestamp;
+	slot->button = button;
+	slot->down = event->type == SDL_KEYDOWN;
+	SDL_AtomicSet(&queue->head, head + 1); /* Publishes the slot */
+	return (1);
+}
+
+/**
+ * input_queue_start - Starts queueing key events
+ * @queue: Queue to initialize
+ */
+void input_queue_start(InputQueue *queue)
+{
+	SDL_AtomicSet(&queue->head, 0);
+	SDL_AtomicSet(&queue->tail, 0);
+	SDL_AtomicSet(&queue->overflow, 0);
+	queue->held = 0;
+	SDL_AddEventWatch(input_watch, queue);
+}
+
+/**
+ * input_queue_stop - Stops queueing key events
+ * @queue: Queue passed to input_queue_start()
+ */
+void input_queue_stop(InputQueue *queue)
+{
+	SDL_DelEventWatch(input_watch, queue);
+}
+
+/**
+ * input_queue_tick - Builds one tick's input from the queued events
+ * @queue: Input queue
+ * @input: Receives the tick's buttons
+ * @until: SDL time the tick is due; later events are left for later ticks
+ *
+ * A button counts as held for the tick if it is down at the end of the
+ * tick or was pressed at any point during it, so a tap shorter than a
+ * tick still reaches the simulation. If the ring overflowed the held
+ * buttons are re-read from the keyboard state instead.
+ */
+void input_queue_tick(InputQueue *queue, Input *input, Uint32 until)
+{
+	int tail = SDL_AtomicGet(&queue->tail);
+	int head = SDL_AtomicGet(&queue->head);
+	InputEvent *event;
+	Uint8 pressed = 0;
+
+	for (; tail != head; tail++)
+	{
+		event = &queue->events[tail & (INPUT_QUEUE_SIZE - 1)];
+		if ((Sint32)(event->timestamp - until) > 0)
+			break;
+		if (event->down)
+			pressed |= event->button;
+		queue->held = event->down ? queue->held | event->button :
+			queue->held & ~event->button;
+	}
+	SDL_AtomicSet(&queue->tail, tail);
+	if (SDL_AtomicSet(&queue->overflow, 0))
+	{
+		input_from_keyboard(input, SDL_GetKeyboardState(NULL));
+		queue->held = input->buttons;
+	}
+	input->buttons = queue->held | pressed;
+}
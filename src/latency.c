@@ -0,0 +1,99 @@
+#include "../inc/maze.h"
+#include "../inc/hud.h"
+
+/**
+ * latency_input - Notes an input event that the game should react to
+ * @latency: Latency histogram
+ * @timestamp: SDL timestamp of the event
+ *
+ * Events arriving before the pending one is shown are folded into it;
+ * the oldest one is what the player waits on.
+ */
+void latency_input(LatencyHistogram *latency, Uint32 timestamp)
+{
+	if (latency->pending)
+		return;
+	latency->pending = 1;
+	latency->since = timestamp;
+}
+
+/**
+ * latency_frame - Closes the pending sample once a frame shows the input
+ * @latency: Latency histogram
+ * @ticks: Simulation ticks run since the events were polled
+ * @drawn: What render_frame() did
+ * @now: SDL_GetTicks() time right after the present
+ *
+ * Keyboard state is sampled by the first tick after the event, so the
+ * first frame presented after that tick reflects it. If that frame was
+ * skipped the input changed nothing visible and no sample is taken.
+ */
+void latency_frame(LatencyHistogram *latency, int ticks, int drawn,
+		Uint32 now)
+{
+	Uint32 ms = now - latency->since;
+	int bucket = ms / LATENCY_BUCKET_MS;
+
+	if (!latency->pending || ticks <= 0)
+		return;
+	latency->pending = 0;
+	if (drawn == FRAME_SKIPPED)
+		return;
+	latency->counts[bucket < LATENCY_BUCKETS ? bucket :
+		LATENCY_BUCKETS - 1]++;
+	latency->samples++;
+	if (ms > latency->worst)
+		latency->worst = ms;
+}
+
+/**
+ * latency_percentile - Latency below which a share of the samples fall
+ * @latency: Latency histogram
+ * @percent: Share of samples, 1 to 100
+ * Return: Upper edge of the bucket holding the percentile, in ms, or 0
+ * without samples
+ */
+int latency_percentile(const LatencyHistogram *latency, int percent)
+{
+	Uint32 wanted = (latency->samples * percent + 99) / 100, seen = 0;
+	int bucket;
+
+	if (!latency->samples)
+		return (0);
+	for (bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++)
+	{
+		seen += latency->counts[bucket];
+		if (seen >= wanted)
+			break;
+	}
+	return ((bucket + 1) * LATENCY_BUCKET_MS);
+}
+
+/**
+ * latency_report - Prints the latency histogram
+ * @latency: Latency histogram
+ */
+void latency_report(const LatencyHistogram *latency)
+{
+	Uint32 peak = 0;
+	int bucket, bar;
+
+	printf("Input latency: %u samples, p50 %d ms, p95 %d ms, p99 %d ms, "
+		"worst %u ms\n", latency->samples, latency_percentile(latency, 50),
+		latency_percentile(latency, 95), latency_percentile(latency, 99),
+		latency->worst);
+	for (bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+		if (latency->counts[bucket] > peak)
+			peak = latency->counts[bucket];
+	for (bucket = 0; bucket < LATENCY_BUCKETS && peak; bucket++)
+	{
+		if (!latency->counts[bucket])
+			continue;
+		printf("%3d ms%s %6u ", bucket * LATENCY_BUCKET_MS,
+			bucket == LATENCY_BUCKETS - 1 ? "+" : " ",
+			latency->counts[bucket]);
+		for (bar = 0; bar < (int)(latency->counts[bucket] * 50 / peak); bar++)
+			putchar('#');
+		putchar('\n');
+	}
+}
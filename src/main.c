@@ -1,76 +1,175 @@
 #include "../inc/maze.h"
 #include "../inc/weapon_sprites.h"
+#include "../inc/capture.h"
+#include "../inc/golden.h"
+#include "../inc/options.h"
+#include "../inc/session.h"
 
 /**
  * handle_events - Handles SDL events (e.g., quitting, key presses)
  * @running: Pointer to the running state of the game
  * @game_state: Pointer to the GameState structure
+ * @session: Session whose render buffers follow the window size
+ *
+ * A drag-resize delivers a burst of size events; only the last size is
+ * applied, once, after the queue is drained.
  */
-void handle_events(int *running, GameState *game_state)
+void handle_events(int *running, GameState *game_state, Session *session)
 {
 SDL_Event event;
+int width = 0, height = 0;
 
 while (SDL_PollEvent(&event))
 	{
 	if (event.type == SDL_QUIT)
 		*running = 0;
-	else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_m)
-		toggle_minimap(game_state);
+	else if (event.type == SDL_KEYDOWN)
+		minimap_key(game_state, event.key.keysym.sym);
+	if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_BACKSPACE)
+		session->rewinds++;
+	if ((event.type == SDL_KEYDOWN && !event.key.repeat) ||
+		event.type == SDL_KEYUP)
+		latency_input(&session->stats.latency, event.common.timestamp);
+	else if (event.type == SDL_WINDOWEVENT &&
+		event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+	{
+		width = event.window.data1;
+		height = event.window.data2;
+	}
+	else if (event.type == SDL_WINDOWEVENT &&
+		event.window.event == SDL_WINDOWEVENT_EXPOSED)
+		session->fb.valid = 0; /* The window contents were lost */
+	else if (event.type == SDL_RENDER_TARGETS_RESET)
+		session->minimap.valid = 0;
+	else if (event.type == SDL_RENDER_DEVICE_RESET)
+		minimap_cleanup(&session->minimap);
 	}
+if (width > 0 && height > 0)
+	session_resize(session, width, height);
 }
 
 /**
  * render_frame - Renders a single frame of the game
- * @renderer: SDL renderer
+ * @session: Renderer, framebuffer, view and the HUD's text and stats
  * @player: Pointer to the player object
- * @textures: Pointer to the Textures structure
  * @game_state: Pointer to the GameState structure
  * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: FRAME_SKIPPED, FRAME_OVERLAY or FRAME_FULL
+ *
+ * While the player stands still nothing is drawn at all, and when only
+ * sprites or the HUD change the cast 3D view is presented again as is.
  */
-void render_frame(SDL_Renderer *renderer, Player *player,
-Textures *textures, GameState *game_state, WeaponSystem *weapon_system)
+int render_frame(Session *session, Player *player, GameState *game_state,
+WeaponSystem *weapon_system)
 {
-const Uint8 *keyboard = SDL_GetKeyboardState(NULL);
+SDL_Renderer *renderer = session->renderer;
+Framebuffer *fb = &session->fb;
+Uint32 world = hash_bytes(world_key(fb, &session->view, player,
+	weapon_system->lightmap), &session->particles.version, sizeof(Uint32));
+Uint32 frame = frame_key(renderer, world, game_state, weapon_system,
+	&session->stats);
+int drawn = FRAME_OVERLAY;
 
+if (fb->valid && frame == fb->frame_key)
+	return (FRAME_SKIPPED);
 SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 SDL_RenderClear(renderer);
 
-update_player(player, keyboard, maze);
-update_weapon_system(weapon_system, player, keyboard, maze);
-
-cast_rays(renderer, player, maze, textures);
+if (!fb->valid || world != fb->world_key)
+{
+	clear_framebuffer(fb);
+	cast_rays(fb, &session->view, player, maze, &session->textures,
+		weapon_system->lightmap);
+	particles_draw(&session->particles, fb, &session->view, player);
+	resolve_framebuffer(fb);
+	upload_framebuffer(fb);
+	drawn = FRAME_FULL;
+}
+present_framebuffer(renderer, fb);
+fb->valid = 1;
+fb->world_key = world;
+fb->frame_key = frame;
 
-/* Render weapon system elements */
-render_weapon_system(renderer, player, weapon_system);
+/* Render weapon system elements and the HUD */
+render_weapon_system(renderer, player, weapon_system, &game_state->input,
+	session->view.fov);
+draw_hud(renderer, &session->text, weapon_system, &session->stats);
 
 /* Draw minimap with player and entities */
-draw_minimap(renderer, player, game_state, weapon_system);
+draw_minimap(renderer, &session->minimap, player, game_state, weapon_system);
 SDL_RenderPresent(renderer);
+return (drawn);
 }
 
 /**
- * main - Entry point of the Maze Game
- * Return: 0 on success, 1 on failure
+ * run_ticks - Runs every simulation tick that is due
+ * @session: Session holding the replay and its tick length
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player object
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: Number of ticks run, -1 once a played-back replay has ended
+ *
+ * The simulation advances in fixed steps of replay.tick_ms however fast
+ * frames are drawn. After a long stall at most MAX_TICKS_PER_FRAME are
+ * caught up and the rest of the backlog is dropped.
+ *
+ * Each caught-up tick takes only the key events from before it was due,
+ * so input during a long frame is spread over the ticks it happened in;
+ * the last tick takes everything up to now.
  */
-int main(void)
+static int run_ticks(Session *session, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system)
+{
+Uint32 now = SDL_GetTicks();
+Uint32 tick_ms = session->replay.tick_ms;
+Input live;
+int steps;
+
+for (steps = 0; SDL_TICKS_PASSED(now, session->next_tick); steps++)
+{
+	if (steps == MAX_TICKS_PER_FRAME)
+	{
+		session->next_tick = now;
+		break;
+	}
+	input_queue_tick(&session->input, &live,
+		SDL_TICKS_PASSED(now, session->next_tick + tick_ms) ?
+		session->next_tick : now);
+	if (step_game(game_state, player, weapon_system,
+		&session->replay, &live) != 0)
+		return (-1);
+	rewind_capture(&session->rewind, &session->replay, game_state, player,
+		weapon_system);
+	play_cues(&session->cues, game_state->tick, weapon_system, player,
+		&session->audio, &session->particles);
+	particles_update(&session->particles, tick_ms / 1000.0f);
+	session->next_tick += tick_ms;
+}
+return (steps);
+}
+
+/**
+ * run_game - Runs the main loop until the player quits
+ * @session: Renderer, framebuffer and per-run systems
+ * Return: 0 on success, 1 if a played-back replay diverged
+ */
+static int run_game(Session *session)
 {
-SDL_Window *window = NULL;
-SDL_Renderer *renderer = NULL;
 Player player;
-Textures textures;
 GameState game_state = {0};
 WeaponSystem weapon_system = {0};
-int running = 1;
+int running = 1, drawn, ticks;
 SDL_Surface *resized = NULL;
+Uint64 start;
+Uint32 now;
+double ms;
 
-if (init_sdl(&window, &renderer) != 0 || init_textures(&textures) != 0)
-{
-	printf("Initialization failed\n");
-	cleanup(window, renderer);
-	return (1);
-}
-
-init_player(&player, 1.5, 1.5, 0);
+game_init(&game_state, &player, &weapon_system, session->replay.seed);
+player.weapon_sprite = create_weapon_sprite(200, 150);
+lightmap_bake(&session->lightmap, maze);
+session->minimap.valid = 0;
+weapon_system.lightmap = &session->lightmap;
+weapon_system.jobs = &session->jobs;
 if (player.weapon_sprite->w > 200 || player.weapon_sprite->h > 200)
 {
 	resized = resize_surface(player.weapon_sprite, 200, 200);
@@ -80,17 +179,138 @@ if (player.weapon_sprite->w > 200 || player.weapon_sprite->h > 200)
 		player.weapon_sprite = resized;
 	}
 }
+if (checkpoint_start(session, &game_state, &player, &weapon_system) != 0)
+{
+	cleanup_weapon_sprite(&player);
+	return (1);
+}
 
+session->next_tick = SDL_GetTicks();
+session->stats.window_start = session->next_tick;
 while (running)
 {
-	handle_events(&running, &game_state);
-	render_frame(renderer, &player, &textures, &game_state, &weapon_system);
+	handle_events(&running, &game_state, session);
+	ticks = session->client ? remote_ticks(session, &game_state, &player,
+		&weapon_system) : run_ticks(session, &game_state, &player,
+		&weapon_system);
+	if (ticks < 0)
+		break;
+	checkpoint_frame(session, &game_state, &player, &weapon_system);
+	start = SDL_GetPerformanceCounter();
+	capture_acquire(session->capture, &session->fb);
+	drawn = render_frame(session, &player, &game_state, &weapon_system);
+	capture_submit(session->capture, &session->fb);
+	ms = (SDL_GetPerformanceCounter() - start) * 1000.0 /
+		SDL_GetPerformanceFrequency();
+	now = SDL_GetTicks();
+	latency_frame(&session->stats.latency, ticks, drawn, now);
+	frame_stats_add(&session->stats, ms, now);
+	/* Only frames that cast the 3D view say anything about its cost */
+	if (drawn == FRAME_FULL)
+		resolution_update(&session->scaler, &session->fb, ms);
 
-	SDL_Delay(16);
+	/* Nothing new to draw before the next tick is due */
+	pacer_wait(&session->pacer, session->next_tick, drawn != FRAME_SKIPPED);
 }
-
+if (session->report_latency)
+	latency_report(&session->stats.latency);
+checkpoint_finish(session, &game_state, &player, &weapon_system);
 cleanup_weapon_sprite(&player);
-cleanup_textures(&textures);
-cleanup(window, renderer);
-return (0);
+return (replay_finish(&session->replay, game_state_hash(&game_state,
+	&player, &weapon_system)) != 0);
+}
+
+/**
+ * main - Entry point of the Maze Game
+ * @argc: Argument count
+ * @argv: Argument vector
+ * Return: 0 on success, 1 on failure
+ */
+int main(int argc, char **argv)
+{
+SDL_Window *window = NULL;
+Session session = {0};
+Capture capture;
+Client client;
+Options options;
+int status = parse_options(argc, argv, &options);
+Uint32 tick_ms = options.tick_rate > 0 && options.tick_rate <= 1000 ?
+	TICK_MS_AT(options.tick_rate) : TICK_MS;
+
+if (status != 0)
+	return (status < 0);
+if (options.bench_entities > 0)
+	return (run_entity_bench(options.bench_entities));
+if (options.bench_particles > 0)
+	return (run_particle_bench(options.bench_particles));
+if (options.golden_dir)
+	return (run_golden(options.golden_dir, options.golden_write,
+		options.budget_scale, options.fixed, options.transpose));
+if (options.bench_engines)
+	return (run_engine_bench(options.bench_engines));
+if (options.load_path && (options.replay_path || options.record_path ||
+	options.connect))
+{
+	printf("--load cannot be combined with --replay, --record or --connect\n");
+	return (1);
+}
+if (options.replay_path ? replay_play_start(&session.replay,
+	options.replay_path) : replay_record_start(&session.replay,
+	options.record_path, options.seed, tick_ms))
+	return (1);
+if (options.connect)
+{
+	if (client_start(&client, options.connect) != 0)
+		return (1);
+	session.client = &client;
+}
+session.rays = options.rays;
+session.load_path = options.load_path;
+session.save_path = options.save_path;
+session.autosave = options.autosave;
+session.report_latency = options.latency;
+pacer_init(&session.pacer, options.vsync);
+if (init_sdl(&window, &session.renderer, options.window_width,
+	options.window_height, options.vsync) != 0 ||
+	init_textures(&session.textures, options.fog) != 0 ||
+	init_framebuffer(&session.fb, session.renderer, session.rays > 0 ?
+	session.rays : options.window_width, options.window_height) != 0 ||
+	text_init(&session.text, session.renderer) != 0)
+{
+	printf("Initialization failed\n");
+	cleanup(window, session.renderer);
+	return (1);
+}
+input_queue_start(&session.input);
+if (audio_open(&session.audio, options.volume) != 0)
+	printf("Running without sound\n");
+if (particles_init(&session.particles, PARTICLES_MAX) != 0)
+	printf("Running without particles\n");
+job_pool_init(&session.jobs, options.threads);
+view_init(&session.view, options.fov, options.max_depth, &session.jobs);
+session.view.fixed = options.fixed;
+session.fb.transposed = options.transpose;
+resolution_init(&session.scaler, options.target_ms, options.scale);
+resolution_apply(&session.scaler, &session.fb);
+if (options.capture_path && capture_start(&capture, options.capture_path,
+	session.fb.max_width, session.fb.max_height) == 0)
+	session.capture = &capture;
+
+status = run_game(&session);
+
+if (session.capture)
+	capture_stop(session.capture);
+input_queue_stop(&session.input);
+audio_close(&session.audio);
+particles_free(&session.particles);
+if (session.client)
+	client_stop(session.client);
+minimap_cleanup(&session.minimap);
+text_cleanup(&session.text);
+view_cleanup(&session.view);
+job_pool_destroy(&session.jobs);
+cleanup_framebuffer(&session.fb);
+cleanup_textures(&session.textures);
+cleanup(window, session.renderer);
+return (status);
 }
@@ -1,32 +1,17 @@
 #include "../inc/maze.h"
 #include "../inc/weapon_sprites.h" /* Include for WeaponSystem */
 
-/* Define the Maze Grid */
-const int maze[MAZE_ROWS][MAZE_COLS] = {
-{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-{1, 0, 0, 0, 0, 1, 1, 0, 0, 0, 3, 0, 1, 0, 1},
-{1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1},
-{1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1},
-{1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1},
-{1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1},
-{1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1},
-{1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1},
-{1, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1},
-{1, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1},
-{1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1},
-{1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
-{1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-{1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
-{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}
-};
-
 /**
  * init_sdl - Initializes SDL and creates window and renderer
  * @window: Pointer to SDL_Window
  * @renderer: Pointer to SDL_Renderer
+ * @width: Initial window width
+ * @height: Initial window height
+ * @vsync: 1 to synchronize presents with the display refresh
  * Return: 0 on success, 1 on failure
  */
-int init_sdl(SDL_Window **window, SDL_Renderer **renderer)
+int init_sdl(SDL_Window **window, SDL_Renderer **renderer,
+		int width, int height, int vsync)
 {
 	if (SDL_Init(SDL_INIT_VIDEO) != 0)
 	{
@@ -41,8 +26,11 @@ int init_sdl(SDL_Window **window, SDL_Renderer **renderer)
 	}
 
 	*window = SDL_CreateWindow("Maze Game", SDL_WINDOWPOS_CENTERED,
-							SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
-	*renderer = SDL_CreateRenderer(*window, -1, SDL_RENDERER_ACCELERATED);
+							SDL_WINDOWPOS_CENTERED, width, height,
+							SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+	if (*window)
+		*renderer = SDL_CreateRenderer(*window, -1, SDL_RENDERER_ACCELERATED |
+			(vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
 
 	if (!*window || !*renderer)
 	{
@@ -63,6 +51,28 @@ void toggle_minimap(GameState *game_state)
 	game_state->show_minimap = !game_state->show_minimap;
 }
 
+/**
+ * minimap_key - Handles the minimap keys
+ * @game_state: Pointer to the GameState structure
+ * @key: Key pressed; M toggles the minimap, - and = zoom out and in
+ *
+ * Zooming changes the span two cells at a time, so the player stays on
+ * the center cell, from MINIMAP_SPAN_MIN up to the whole maze.
+ */
+void minimap_key(GameState *game_state, SDL_Keycode key)
+{
+	int whole = MAZE_COLS > MAZE_ROWS ? MAZE_COLS : MAZE_ROWS;
+	int span = game_state->minimap_span > 0 ? game_state->minimap_span : whole;
+
+	if (key == SDLK_m)
+		toggle_minimap(game_state);
+	else if (key == SDLK_MINUS)
+		span += 2;
+	else if (key == SDLK_EQUALS)
+		span -= 2;
+	span = span < MINIMAP_SPAN_MIN ? MINIMAP_SPAN_MIN : span;
+	game_state->minimap_span = span >= whole ? 0 : span;
+}
 
 /**
  * cleanup - Frees resources and quits SDL
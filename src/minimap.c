@@ -1,93 +1,164 @@
 #include "../inc/maze.h"
+#include "../inc/minimap.h"
 
 /**
- * draw_minimap_cell - Draws a single cell of the minimap
- * @renderer: Pointer to SDL_Renderer
- * @cell: SDL_Rect representing the cell
- * @is_wall: Whether the cell is a wall
+ * minimap_bake - Draws every maze cell into the cached wall layer
+ * @renderer: SDL renderer
+ * @minimap: Minimap whose layer is (re)drawn
+ *
+ * Runs once per map load, or after the renderer lost its render targets.
+ * The walls go out in a single batched call.
  */
-void draw_minimap_cell(SDL_Renderer *renderer, SDL_Rect cell, int is_wall)
+static void minimap_bake(SDL_Renderer *renderer, Minimap *minimap)
 {
-const int wall_margin = 2;
+	SDL_Rect walls[MAZE_ROWS * MAZE_COLS];
+	const int margin = MINIMAP_CELL_PX / 3, size = MINIMAP_CELL_PX - margin * 2;
+	int row, col, count = 0;
 
-if (is_wall)
-{
-SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-SDL_Rect wall = {
-cell.x + wall_margin,
-cell.y + wall_margin,
-cell.w - (wall_margin * 2),
-cell.h - (wall_margin * 2)
-};
-SDL_RenderFillRect(renderer, &wall);
-}
-else
-{
-SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-SDL_RenderFillRect(renderer, &cell);
-}
+	minimap->valid = 1;
+	if (!minimap->layer)
+		minimap->layer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+			SDL_TEXTUREACCESS_TARGET, MAZE_COLS * MINIMAP_CELL_PX,
+			MAZE_ROWS * MINIMAP_CELL_PX);
+	if (minimap->layer) /* Keep the walls crisp when scaled */
+		SDL_SetTextureScaleMode(minimap->layer, SDL_ScaleModeNearest);
+	if (!minimap->layer || SDL_SetRenderTarget(renderer, minimap->layer) != 0)
+	{
+		printf("Minimap layer failed: %s\n", SDL_GetError());
+		minimap_cleanup(minimap);
+		minimap->valid = 1; /* Show markers only rather than retry each frame */
+		return;
+	}
+	for (row = 0; row < MAZE_ROWS; row++)
+		for (col = 0; col < MAZE_COLS; col++)
+			if (maze[row][col])
+			{
+				walls[count].x = col * MINIMAP_CELL_PX + margin;
+				walls[count].y = row * MINIMAP_CELL_PX + margin;
+				walls[count].w = size;
+				walls[count++].h = size;
+			}
+	SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+	SDL_RenderClear(renderer);
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	SDL_RenderFillRects(renderer, walls, count);
+	SDL_SetRenderTarget(renderer, NULL);
 }
 
 /**
- * draw_minimap_background - Draws the minimap background.
- * @renderer: SDL renderer.
- * @map_x: X position of the minimap.
- * @map_y: Y position of the minimap.
- * @map_size: Size of the minimap.
+ * minimap_viewport - Picks the part of the maze the minimap shows
+ * @view: Receives the on-screen placement
+ * @source: Receives the matching rectangle of the wall layer
+ * @player: The view is centered on the player
+ * @span: Cells across the minimap, 0 for the whole maze
+ * @screen_w: Renderer output width
+ *
+ * Scrolling stops at the maze border, so a maze no wider than the span
+ * is shown whole and does not move.
  */
-void draw_minimap_background(SDL_Renderer *renderer, int map_x,
-int map_y, int map_size)
+static void minimap_viewport(MinimapView *view, SDL_Rect *source,
+			const Player *player, int span, int screen_w)
 {
-SDL_Rect background = {map_x - 5, map_y - 5, map_size + 10, map_size + 10};
+	int cols, rows;
+	float left, top;
 
-SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-SDL_RenderFillRect(renderer, &background);
+	if (span <= 0)
+		span = MAZE_COLS > MAZE_ROWS ? MAZE_COLS : MAZE_ROWS;
+	cols = span < MAZE_COLS ? span : MAZE_COLS;
+	rows = span < MAZE_ROWS ? span : MAZE_ROWS;
+	left = player->x - cols / 2.0f;
+	top = player->y - rows / 2.0f;
+	left = left < 0 ? 0 : left > MAZE_COLS - cols ? MAZE_COLS - cols : left;
+	top = top < 0 ? 0 : top > MAZE_ROWS - rows ? MAZE_ROWS - rows : top;
+
+	/* Snap to whole texels so the walls and markers scroll together */
+	source->x = (int)(left * MINIMAP_CELL_PX);
+	source->y = (int)(top * MINIMAP_CELL_PX);
+	source->w = cols * MINIMAP_CELL_PX;
+	source->h = rows * MINIMAP_CELL_PX;
+	view->left = (float)source->x / MINIMAP_CELL_PX;
+	view->top = (float)source->y / MINIMAP_CELL_PX;
+	view->scale = MINIMAP_SIZE / span;
+	view->rect.x = screen_w - MINIMAP_SIZE - MINIMAP_MARGIN;
+	view->rect.y = MINIMAP_MARGIN;
+	view->rect.w = cols * view->scale;
+	view->rect.h = rows * view->scale;
 }
 
 /**
- * draw_minimap_cells - Renders the maze cells on the minimap.
+ * draw_bullets_minimap - Draws bullet dots on the minimap.
  * @renderer: SDL renderer.
- * @map_x: X position of the minimap.
- * @map_y: Y position of the minimap.
- * @cell_size: Size of each cell in the minimap.
+ * @view: Placement of the minimap.
+ * @weapon_system: Pointer to weapon system.
  */
-void draw_minimap_cells(SDL_Renderer *renderer, int map_x,
-int map_y, int cell_size)
+void draw_bullets_minimap(SDL_Renderer *renderer, const MinimapView *view,
+			WeaponSystem *weapon_system)
 {
-int row, col;
+	SDL_Rect dot = {0, 0, 2, 2};
+	int i;
 
-for (row = 0; row < MAZE_ROWS; row++)
-{
-for (col = 0; col < MAZE_COLS; col++)
-{
-SDL_Rect cell = {
-map_x + (col * cell_size),
-map_y + (row * cell_size),
-cell_size, cell_size
-};
-draw_minimap_cell(renderer, cell, maze[row][col]);
-}
-}
+	SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		if (!weapon_system->bullets[i].active)
+			continue;
+		dot.x = MINIMAP_X(view, weapon_system->bullets[i].x);
+		dot.y = MINIMAP_Y(view, weapon_system->bullets[i].y);
+		SDL_RenderFillRect(renderer, &dot);
+	}
 }
 
 /**
  * draw_minimap - Main function to draw the minimap.
  * @renderer: SDL renderer.
+ * @minimap: Cached wall layer, drawn first if not valid.
  * @player: Pointer to player structure.
  * @game_state: Pointer to game state structure.
  * @weapon_system: Pointer to weapon system.
+ *
+ * Costs one texture copy plus a marker per entity, however large the
+ * maze is.
  */
-void draw_minimap(SDL_Renderer *renderer, const Player *player,
-GameState *game_state, WeaponSystem *weapon_system)
+void draw_minimap(SDL_Renderer *renderer, Minimap *minimap,
+		const Player *player, GameState *game_state,
+		WeaponSystem *weapon_system)
 {
-const int map_size = 100, map_y = 10, cell_size = map_size / MAZE_ROWS;
-const int map_x = SCREEN_WIDTH - map_size - 10;
+	MinimapView view;
+	SDL_Rect source, background;
+	int screen_w;
+
+	if (!game_state->show_minimap)
+		return;
+	if (!minimap->valid)
+		minimap_bake(renderer, minimap);
+
+	SDL_GetRendererOutputSize(renderer, &screen_w, NULL);
+	minimap_viewport(&view, &source, player, game_state->minimap_span,
+		screen_w);
+	background.x = view.rect.x - 5;
+	background.y = view.rect.y - 5;
+	background.w = MINIMAP_SIZE + 10;
+	background.h = MINIMAP_SIZE + 10;
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+	SDL_RenderFillRect(renderer, &background);
+	if (minimap->layer)
+		SDL_RenderCopy(renderer, minimap->layer, &source, &view.rect);
 
-if (!game_state->show_minimap)
-return;
+	SDL_RenderSetClipRect(renderer, &view.rect);
+	draw_minimap_enemies(renderer, &view, weapon_system, player);
+	draw_bullets_minimap(renderer, &view, weapon_system);
+	draw_minimap_player(renderer, &view, player);
+	SDL_RenderSetClipRect(renderer, NULL);
+}
 
-draw_minimap_background(renderer, map_x, map_y, map_size);
-draw_minimap_cells(renderer, map_x, map_y, cell_size);
-draw_minimap_enemies(renderer, map_x, map_y, cell_size, weapon_system);
-draw_minimap_player(renderer, map_x, map_y, cell_size, player);
+/**
+ * minimap_cleanup - Frees the cached wall layer
+ * @minimap: Minimap; drawn again from scratch if used afterwards
+ */
+void minimap_cleanup(Minimap *minimap)
+{
+	if (minimap->layer)
+		SDL_DestroyTexture(minimap->layer);
+	minimap->layer = NULL;
+	minimap->valid = 0;
 }
@@ -0,0 +1,130 @@
+#include "../inc/maze.h"
+#include "../inc/options.h"
+#include "../inc/audio.h"
+#include <string.h>
+
+/**
+ * print_usage - Prints command line help
+ * @name: Program name
+ */
+static void print_usage(const char *name)
+{
+	printf("Usage: %s [--name value]...\n"
+		"  --config FILE    Read \"name = value\" lines from FILE\n"
+		"                   (default: " CONFIG_DEFAULT_PATH " if present)\n"
+		"  --capture FILE   Record gameplay to FILE (.y4m or raw RGB24)\n"
+		"  --seed N         Seed the game RNG (default: current time)\n"
+		"  --record FILE    Record per-tick input to FILE\n"
+		"  --replay FILE    Play back input recorded with --record\n"
+		"  --golden-check DIR  Render test scenes headlessly, compare them\n"
+		"                   with DIR/*.png and check frame-time budgets\n"
+		"  --golden-write DIR  Rewrite the golden images in DIR\n"
+		"  --budget-scale F Multiply golden frame-time budgets by F\n"
+		"  --bench-engines DIR  Time the float and fixed-point renderers,\n"
+		"                   row- and column-major, on the golden scenes\n"
+		"                   and compare with DIR\n"
+		"  --target-ms F    Lower render resolution to hold F ms per frame\n"
+		"                   (default 12, 0 keeps the resolution fixed)\n"
+		"  --scale F        Initial render scale, 0.4 to 1 (default 1)\n"
+		"  --window-width N, --window-height N  Window size (700x600)\n"
+		"  --fov F          Field of view in degrees (default 60)\n"
+		"  --rays N         Rays at full scale (default: window width)\n"
+		"  --max-depth F    Ray length in cells (default 10)\n"
+		"  --threads N      Render threads, 0 for one per core (default 0)\n"
+		"  --vsync 0|1      Synchronize with the display (default 0)\n"
+		"  --tick-rate N    Simulation ticks per second (default 62)\n"
+		"  --fog 0xRRGGBB   Color distant surfaces fade into (default black)\n"
+		"  --latency 0|1    Print an input latency histogram on exit\n"
+		"  --bench-entities N  Time enemy and bullet updates of N of each\n"
+		"                   on 1 to 16 threads and check they agree\n"
+		"  --bench-particles N  Time particle updates and drawing of up\n"
+		"                   to N particles\n"
+		"  --connect ADDR   Join a maze_sim --serve game at [IP:]PORT;\n"
+		"                   the first client to join controls the player\n"
+		"  --load FILE      Start from a game saved with --save\n"
+		"  --save FILE      Save the game to FILE on exit\n"
+		"  --autosave N     Also save to the --save file every N seconds\n"
+		"  --volume N       Sound volume, 0 to 100, 0 for none (default 80)\n"
+		"  --fixed 0|1      Render with 16.16 fixed-point math (default 0)\n"
+		"  --transpose 0|1  Render columns into a column-major buffer and\n"
+		"                   transpose it for presenting; faster only at\n"
+		"                   large render sizes (default 0)\n"
+		"  --help           Show this help\n", name);
+}
+
+/**
+ * set_defaults - Fills in the default value of every option
+ * @options: Options to reset
+ */
+static void set_defaults(Options *options)
+{
+	memset(options, 0, sizeof(*options));
+	options->seed = (Uint32)time(NULL);
+	options->budget_scale = 1.0;
+	options->target_ms = 12.0;
+	options->scale = 1.0f;
+	options->window_width = SCREEN_WIDTH;
+	options->window_height = SCREEN_HEIGHT;
+	options->fov = FOV;
+	options->max_depth = MAX_DEPTH;
+	options->tick_rate = 1000 / TICK_MS;
+	options->fog = FOG_COLOR;
+	options->volume = AUDIO_DEFAULT_VOLUME;
+}
+
+/**
+ * find_config - Looks for --config on the command line
+ * @argc: Argument count
+ * @argv: Argument vector
+ * Return: Config path, or NULL to use the default
+ */
+static const char *find_config(int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i + 1 < argc; i++)
+		if (strcmp(argv[i], "--config") == 0)
+			return (argv[i + 1]);
+	return (NULL);
+}
+
+/**
+ * parse_options - Loads the config file, then applies command line options
+ * @argc: Argument count
+ * @argv: Argument vector
+ * @options: Receives the parsed options
+ * Return: 0 to continue, 1 if the program should exit successfully,
+ * -1 on invalid arguments
+ */
+int parse_options(int argc, char **argv, Options *options)
+{
+	const char *config = find_config(argc, argv);
+	int i, result;
+
+	set_defaults(options);
+	if (load_config(options, config ? config : CONFIG_DEFAULT_PATH,
+		config != NULL) != 0)
+		return (-1);
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--help") == 0)
+		{
+			print_usage(argv[0]);
+			return (1);
+		}
+		result = strncmp(argv[i], "--", 2) != 0 || i + 1 >= argc ? -1 :
+			strcmp(argv[i], "--config") == 0 ? 0 :
+			set_option(options, argv[i] + 2, argv[i + 1]);
+		if (result != 0)
+		{
+			if (result == -2)
+				printf("Invalid value for %s: %s\n", argv[i], argv[i + 1]);
+			else
+				printf("Unknown or incomplete option: %s\n", argv[i]);
+			print_usage(argv[0]);
+			return (-1);
+		}
+		i++;
+	}
+	return (0);
+}
@@ -0,0 +1,51 @@
+#include "../inc/pacer.h"
+#include <math.h>
+
+/**
+ * pacer_init - Sets up a frame pacer
+ * @pacer: Pacer to initialize
+ * @vsync: 1 if the renderer was created with vsync
+ */
+void pacer_init(FramePacer *pacer, int vsync)
+{
+	pacer->vsync = vsync;
+	pacer->oversleep_ms = 1.0f;
+}
+
+/**
+ * pacer_wait - Waits until a deadline
+ * @pacer: Frame pacer
+ * @deadline: SDL_GetTicks() time to wake up at
+ * @presented: 1 if this loop iteration presented a frame
+ *
+ * The bulk of the wait is one sleep that ends the recent worst oversleep
+ * before the deadline; the rest is slept 1 ms at a time, so the loop
+ * wakes at most about a millisecond late and never busy-waits.
+ *
+ * With vsync a present has already waited for the display, so sleeping
+ * on top of it would only miss the next refresh; the pacer then returns
+ * at once. Loops that presented nothing still sleep, or an idle game
+ * would spin.
+ */
+void pacer_wait(FramePacer *pacer, Uint32 deadline, int presented)
+{
+	Uint32 start = SDL_GetTicks();
+	Sint32 remaining = (Sint32)(deadline - start), sleep, over;
+	int margin = (int)ceilf(pacer->oversleep_ms);
+
+	if (remaining <= 0 || (pacer->vsync && presented))
+		return;
+	if (remaining > margin)
+	{
+		sleep = remaining - margin;
+		SDL_Delay(sleep);
+		over = (Sint32)(SDL_GetTicks() - start) - sleep;
+		pacer->oversleep_ms *= PACER_MARGIN_DECAY;
+		if (over > pacer->oversleep_ms)
+			pacer->oversleep_ms = over;
+		if (pacer->oversleep_ms > PACER_MARGIN_MAX)
+			pacer->oversleep_ms = PACER_MARGIN_MAX;
+	}
+	while (!SDL_TICKS_PASSED(SDL_GetTicks(), deadline))
+		SDL_Delay(1);
+}
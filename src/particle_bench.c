@@ -0,0 +1,116 @@
+#include "../inc/effects.h"
+
+#define PARTICLE_BENCH_FRAMES 200  /* Frames run per particle count */
+#define PARTICLE_BENCH_WIDTH 640   /* Render size of the benchmark frame */
+#define PARTICLE_BENCH_HEIGHT 480
+#define PARTICLE_BENCH_BURST 256   /* Particles per refill burst */
+
+/**
+ * bench_refill - Tops the particle system up to a count with bursts
+ * @particles: Particle system
+ * @count: Particles wanted
+ *
+ * Bursts start from random open cells with long enough lives that about
+ * a tenth of the particles die each frame, so culling is measured too.
+ */
+static void bench_refill(Particles *particles, int count)
+{
+	Burst burst = {0, 0, 0.5f, 0, 0, 1.0f, 0.3f, 0xFFFFC060,
+		PARTICLE_BENCH_BURST};
+	int x, y;
+
+	while (particles->count < count)
+	{
+		do {
+			x = rng_next(&particles->rng) % MAZE_COLS;
+			y = rng_next(&particles->rng) % MAZE_ROWS;
+		} while (maze[y][x] != CELL_EMPTY);
+		burst.x = x + 0.5f;
+		burst.y = y + 0.5f;
+		burst.count = count - particles->count < PARTICLE_BENCH_BURST ?
+			count - particles->count : PARTICLE_BENCH_BURST;
+		particles_emit(particles, &burst);
+	}
+}
+
+/**
+ * bench_round - Runs one particle count and prints a row
+ * @fb: Headless framebuffer, with a made-up wall depth per column
+ * @view: Projection settings
+ * @player: Camera
+ * @count: Particles kept alive
+ * Return: 0 on success, -1 on allocation failure
+ */
+static int bench_round(Framebuffer *fb, const View *view,
+		const Player *player, int count)
+{
+	Particles particles;
+	Uint64 start, updating = 0, drawing = 0;
+	double frequency = SDL_GetPerformanceFrequency() / 1000.0;
+	long drawn = 0;
+	int frame;
+
+	if (particles_init(&particles, count) != 0)
+		return (-1);
+	bench_refill(&particles, count);
+	for (frame = 0; frame < PARTICLE_BENCH_FRAMES; frame++)
+	{
+		start = SDL_GetPerformanceCounter();
+		particles_update(&particles, TICK_MS / 1000.0f);
+		updating += SDL_GetPerformanceCounter() - start;
+		bench_refill(&particles, count);
+		start = SDL_GetPerformanceCounter();
+		drawn += particles_draw(&particles, fb, view, player);
+		drawing += SDL_GetPerformanceCounter() - start;
+	}
+	printf("%10d %10.3f %10.3f %10.3f %12.1f\n", count,
+		updating / frequency / PARTICLE_BENCH_FRAMES,
+		drawing / frequency / PARTICLE_BENCH_FRAMES,
+		updating * 1e6 / frequency / PARTICLE_BENCH_FRAMES / count,
+		(double)drawn / PARTICLE_BENCH_FRAMES);
+	particles_free(&particles);
+	return (0);
+}
+
+/**
+ * run_particle_bench - Measures particle update and drawing from 1024
+ * particles up
+ * @max_count: Largest particle count; 1024, 4096... up to it are run
+ * Return: 0 on success, 1 on allocation failure
+ *
+ * Every frame integrates and culls the particles, refills the ones that
+ * died and draws them all into a headless framebuffer whose columns see
+ * walls at a spread of depths, so the depth test rejects some of them.
+ * No walls are cast, so only the particle pass itself is timed.
+ */
+int run_particle_bench(int max_count)
+{
+	Framebuffer fb;
+	View view;
+	Player player = {7.5f, 7.5f, 0, 1, 0, NULL};
+	int x, count, status;
+
+	doors_reset();
+	view_init(&view, FOV, MAX_DEPTH, NULL);
+	status = init_framebuffer(&fb, NULL, PARTICLE_BENCH_WIDTH,
+		PARTICLE_BENCH_HEIGHT) != 0 || view_update(&view, fb.width,
+		fb.height) != 0 ? -1 : 0;
+	for (x = 0; status == 0 && x < fb.width; x++)
+		fb.depth[x] = 1.0f + (x * 7 % 64) / 8.0f;
+	printf("Particles, %d frames at %dx%d\nparticles  update ms"
+		"    draw ms  ns/update  drawn/frame\n", PARTICLE_BENCH_FRAMES,
+		PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT);
+	for (count = 1024; status == 0; count *= 4)
+	{
+		if (count > max_count)
+			count = max_count;
+		status = bench_round(&fb, &view, &player, count);
+		if (count == max_count)
+			break;
+	}
+	if (status != 0)
+		printf("Out of memory\n");
+	view_cleanup(&view);
+	cleanup_framebuffer(&fb);
+	return (status != 0);
+}
@@ -0,0 +1,125 @@
+#include "../inc/effects.h"
+
+/**
+ * view_atan - Fast arctangent for projecting onto the ray columns
+ * @t: Tangent
+ * Return: Angle in radians, within 1e-5 of atanf()
+ *
+ * Ray columns are spaced evenly in angle, so a particle's column needs
+ * its angle from the view direction; a polynomial on [-1, 1] plus the
+ * reciprocal identity outside it is far cheaper than the libm call.
+ */
+static float view_atan(float t)
+{
+	float u = t, t2, angle;
+	int outside = t > 1.0f || t < -1.0f;
+
+	if (outside)
+		u = 1.0f / t;
+	t2 = u * u;
+	angle = u * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f +
+		t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+	if (outside)
+		angle = (t > 0.0f ? (float)M_PI_2 : (float)-M_PI_2) - angle;
+	return (angle);
+}
+
+/**
+ * add_pixel - Adds a color onto a pixel, saturating each channel
+ * @pixel: Framebuffer pixel
+ * @color: ARGB8888 color, already faded
+ *
+ * All three channels are added in one word: the low seven bits of each
+ * add without reaching the next channel, the top bit and its carry are
+ * worked out separately, and channels that carried are filled to 255,
+ * so sparks brighten what is behind them.
+ */
+static void add_pixel(Uint32 *pixel, Uint32 color)
+{
+	Uint32 a = *pixel, low, top, carry;
+
+	low = (a & 0x7F7F7F) + (color & 0x7F7F7F);
+	top = (a ^ color) & 0x808080;
+	carry = ((a & color) | (low & top)) & 0x808080;
+	*pixel = 0xFF000000 | (low ^ top) | ((carry >> 7) * 0xFF);
+}
+
+/**
+ * draw_square - Draws one particle as a square depth-tested per column
+ * @fb: Framebuffer, with the depth of this frame's walls
+ * @col: Column of the centre
+ * @row: Row of the centre
+ * @size: Side in pixels
+ * @distance: Distance of the particle, tested against fb->depth
+ * @color: ARGB8888 color
+ * @fade: Strength, 0 to 256
+ */
+static void draw_square(Framebuffer *fb, int col, int row, int size,
+		float distance, Uint32 color, Uint32 fade)
+{
+	int x, y, left = col - size / 2, top = row - size / 2;
+	int right = left + size, bottom = top + size, step = FB_ROW_STEP(fb);
+	Uint32 *column;
+
+	color = (((color >> 16) & 0xFF) * fade >> 8) << 16 |
+		(((color >> 8) & 0xFF) * fade >> 8) << 8 | ((color & 0xFF) * fade >> 8);
+	left = left < 0 ? 0 : left;
+	top = top < 0 ? 0 : top;
+	right = right > fb->width ? fb->width : right;
+	bottom = bottom > fb->height ? fb->height : bottom;
+	for (x = left; x < right; x++)
+	{
+		if (distance >= fb->depth[x])
+			continue;
+		column = FB_COLUMN(fb, x);
+		for (y = top; y < bottom; y++)
+			add_pixel(&column[y * step], color);
+	}
+}
+
+/**
+ * particles_draw - Draws every live particle into the cast 3D view
+ * @particles: Particle system
+ * @fb: Framebuffer cast_rays() just rendered, with its depth buffer
+ * @view: Projection settings the frame was cast with
+ * @player: Camera
+ * Return: Number of particles drawn
+ *
+ * One pass over the arrays after the walls: each particle is projected
+ * the way cast_column() projects walls, so it sits at the height and
+ * scale a wall at its distance would, and is hidden where the opaque
+ * wall of its column is nearer. Particles fade out over their last
+ * 1 / PARTICLE_FADE seconds.
+ */
+int particles_draw(const Particles *particles, Framebuffer *fb,
+		const View *view, const Player *player)
+{
+	float c = cosf(player->angle), s = sinf(player->angle);
+	float half = view->fov / 2.0f, scale = fb->width / view->fov;
+	float dx, dy, forward, distance, wall, fade;
+	int i, col, size, drawn = 0;
+
+	for (i = 0; i < particles->count; i++)
+	{
+		dx = particles->x[i] - player->x;
+		dy = particles->y[i] - player->y;
+		forward = dx * c + dy * s;
+		if (forward < 0.05f)
+			continue;
+		col = (int)((view_atan((dy * c - dx * s) / forward) + half) * scale);
+		if (col < 0 || col >= fb->width)
+			continue;
+		distance = sqrtf(dx * dx + dy * dy);
+		if (distance >= fb->depth[col])
+			continue;
+		wall = fb->height / distance * 0.8f;
+		size = (int)(PARTICLE_SIZE * wall);
+		fade = particles->life[i] * PARTICLE_FADE;
+		draw_square(fb, col, (int)(fb->height / 2 +
+			(0.5f - particles->z[i]) * wall), size > 1 ? size : 1,
+			distance, particles->color[i],
+			(Uint32)((fade < 1.0f ? fade : 1.0f) * 256.0f));
+		drawn++;
+	}
+	return (drawn);
+}
@@ -0,0 +1,44 @@
+#include "../inc/maze.h"
+#include "../inc/session.h"
+
+/**
+ * remote_ticks - Plays or watches a game simulated by a server
+ * @session: Session holding the server connection
+ * @game_state: Receives the tick and the input sent last
+ * @player: Receives the player to draw
+ * @weapon_system: Receives the enemies, bullets and HUD values to draw
+ * Return: Number of input ticks sent this frame
+ *
+ * Input is gathered per tick exactly as for a local game, but sent to the
+ * server instead of stepping the simulation. What is drawn is the
+ * server's state, interpolated between the snapshots it sent back.
+ */
+int remote_ticks(Session *session, GameState *game_state, Player *player,
+		WeaponSystem *weapon_system)
+{
+	Uint32 now = SDL_GetTicks();
+	Uint32 tick_ms = session->replay.tick_ms;
+	Input live;
+	int steps;
+
+	for (steps = 0; SDL_TICKS_PASSED(now, session->next_tick); steps++)
+	{
+		if (steps == MAX_TICKS_PER_FRAME)
+		{
+			session->next_tick = now;
+			break;
+		}
+		input_queue_tick(&session->input, &live,
+			SDL_TICKS_PASSED(now, session->next_tick + tick_ms) ?
+			session->next_tick : now);
+		client_send(session->client, &live);
+		game_state->input = live;
+		session->next_tick += tick_ms;
+	}
+	client_receive(session->client, now);
+	client_sample(session->client, now, game_state, player, weapon_system);
+	play_cues(&session->cues, game_state->tick, weapon_system, player,
+		&session->audio, &session->particles);
+	particles_update(&session->particles, steps * tick_ms / 1000.0f);
+	return (steps);
+}
@@ -0,0 +1,65 @@
+#include "../inc/resolution.h"
+
+/**
+ * resolution_init - Initializes the dynamic resolution controller
+ * @scaler: Controller to initialize
+ * @target_ms: Frame time to hold, or 0 to keep @scale fixed
+ * @scale: Initial render scale, clamped to [SCALE_MIN, 1]
+ */
+void resolution_init(ResolutionScaler *scaler, double target_ms, float scale)
+{
+	if (scale > 1.0f)
+		scale = 1.0f;
+	if (scale < SCALE_MIN)
+		scale = SCALE_MIN;
+	scaler->scale = scale;
+	scaler->target_ms = target_ms;
+	scaler->average_ms = target_ms;
+	scaler->cooldown = SCALE_COOLDOWN;
+}
+
+/**
+ * resolution_update - Feeds one frame time to the controller
+ * @scaler: Controller
+ * @fb: Framebuffer whose render size is adjusted
+ * @frame_ms: CPU time the last frame took to render
+ */
+void resolution_update(ResolutionScaler *scaler, Framebuffer *fb,
+			double frame_ms)
+{
+	float scale = scaler->scale;
+
+	if (scaler->target_ms <= 0)
+		return;
+	scaler->average_ms = scaler->average_ms * 0.9 + frame_ms * 0.1;
+	if (scaler->cooldown > 0)
+	{
+		scaler->cooldown--;
+		return;
+	}
+	if (scaler->average_ms > scaler->target_ms * 1.05)
+		scale -= SCALE_STEP_DOWN;
+	else if (scaler->average_ms < scaler->target_ms * 0.7)
+		scale += SCALE_STEP_UP;
+	if (scale > 1.0f)
+		scale = 1.0f;
+	if (scale < SCALE_MIN)
+		scale = SCALE_MIN;
+	if (scale != scaler->scale)
+	{
+		scaler->scale = scale;
+		scaler->cooldown = SCALE_COOLDOWN;
+		resolution_apply(scaler, fb);
+	}
+}
+
+/**
+ * resolution_apply - Sets the framebuffer render size from the scale
+ * @scaler: Controller
+ * @fb: Framebuffer to resize (within its allocation)
+ */
+void resolution_apply(const ResolutionScaler *scaler, Framebuffer *fb)
+{
+	framebuffer_set_size(fb, (int)(fb->max_width * scaler->scale + 0.5f),
+		(int)(fb->max_height * scaler->scale + 0.5f));
+}
@@ -0,0 +1,102 @@
+#include "../inc/maze.h"
+
+/**
+ * light_level - Quantizes the brightness of a surface at a distance
+ * @distance: Distance from the camera in cells
+ * Return: Light level, 0 (darkest) to LIGHT_FULL (unlit, point blank)
+ *
+ * Lights raise the level further, up to LIGHT_LEVELS - 1 (overbright).
+ */
+int light_level(float distance)
+{
+	float shade = 1.0f - distance * LIGHT_FALLOFF;
+
+	if (shade <= LIGHT_MIN)
+		return (0);
+	if (shade >= 1.0f)
+		return (LIGHT_FULL);
+	return ((int)((shade - LIGHT_MIN) / LIGHT_STEP + 0.5f));
+}
+
+/**
+ * shade_channel - Shades one color channel
+ * @value: Texel channel value
+ * @shade: Brightness, above 1 for lit surfaces
+ * @fog: Fog channel value, already weighted by how far the level fades
+ * Return: Shaded channel value, saturated at 255
+ */
+static Uint8 shade_channel(Uint32 value, float shade, float fog)
+{
+	float out = (value & 0xFF) * shade + fog;
+
+	return (out >= 255.0f ? 255 : (Uint8)out);
+}
+
+/**
+ * shade_texture - Builds the pre-shaded copies of one texture
+ * @texture: Source texture pixels
+ * @brightness: Extra scale applied before fogging (0.5 for the ceiling)
+ * @fog: Fog color the darker levels blend towards
+ * Return: LIGHT_LEVELS copies of the texture, or NULL on failure
+ *
+ * Levels above LIGHT_FULL are lit surfaces: brighter than the texture
+ * and clear of fog.
+ */
+static Uint32 *shade_texture(const Uint32 *texture, float brightness,
+			Uint32 fog)
+{
+	Uint32 *table = malloc(sizeof(Uint32) * TEXELS * LIGHT_LEVELS);
+	Uint32 *out = table, pixel;
+	float shade, haze, fog_r, fog_g, fog_b;
+	int level, i;
+
+	if (!table)
+		return (NULL);
+	for (level = 0; level < LIGHT_LEVELS; level++)
+	{
+		shade = LIGHT_MIN + LIGHT_STEP * level;
+		haze = shade < 1.0f ? 1.0f - shade : 0.0f;
+		fog_r = ((fog >> 16) & 0xFF) * haze;
+		fog_g = ((fog >> 8) & 0xFF) * haze;
+		fog_b = (fog & 0xFF) * haze;
+		shade *= brightness;
+		for (i = 0; i < TEXELS; i++)
+		{
+			pixel = texture[i];
+			if (!(pixel >> 24))
+			{
+				*out++ = 0; /* Keep holes transparent */
+				continue;
+			}
+			*out++ = FB_RGB(shade_channel(pixel >> 16, shade, fog_r),
+				shade_channel(pixel >> 8, shade, fog_g),
+				shade_channel(pixel, shade, fog_b));
+		}
+	}
+	return (table);
+}
+
+/**
+ * shade_textures - (Re)builds every texture's light level tables
+ * @textures: Loaded textures
+ * @fog: Fog color, 0xRRGGBB
+ * Return: 0 on success, -1 on allocation failure
+ */
+int shade_textures(Textures *textures, Uint32 fog)
+{
+	free(textures->ns_shades);
+	free(textures->ew_shades);
+	free(textures->floor_shades);
+	free(textures->ceiling_shades);
+	free(textures->grate_shades);
+	textures->ns_shades = shade_texture(textures->north_south, 1.0f, fog);
+	textures->ew_shades = shade_texture(textures->east_west, 1.0f, fog);
+	textures->floor_shades = shade_texture(textures->floor, 1.0f, fog);
+	textures->ceiling_shades = shade_texture(textures->floor, 0.5f, fog);
+	textures->grate_shades = shade_texture(textures->grate, 1.0f, fog);
+	if (!textures->ns_shades || !textures->ew_shades ||
+		!textures->floor_shades || !textures->ceiling_shades ||
+		!textures->grate_shades)
+		return (-1);
+	return (0);
+}
@@ -0,0 +1,39 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * ai_schedule - Lists the enemies that run their AI this tick
+ * @update: Entity update; fills @update->due and @update->due_count
+ * Return: Number of enemies due
+ *
+ * Enemies in AI_NEAR_TIER (in sight and within AI_NEAR cells of the
+ * player) run every tick, so chasing and attacks play as before. All
+ * others run in round-robin slices of AI_SLICE per tick, continuing
+ * where the last tick stopped. Each update sets the enemy's tier again,
+ * so an enemy that comes close is promoted within one slice and one that
+ * falls behind drops out of the per-tick list.
+ *
+ * The AI cost of a tick is therefore the near enemies plus one slice,
+ * whatever the enemy count. Below AI_SLICE enemies every enemy runs
+ * every tick. The slice is a count rather than a clock budget so the
+ * schedule is the same on every machine and replays stay exact.
+ */
+int ai_schedule(EntityUpdate *update)
+{
+	int i, k, total = update->enemy_total, count = 0;
+	int slice = total < AI_SLICE ? total : AI_SLICE;
+
+	for (i = 0; i < total; i++)
+		if (update->tiers[i] == AI_NEAR_TIER && update->enemies[i].alive)
+			update->due[count++] = i;
+	for (k = 0; k < slice; k++)
+	{
+		i = (*update->ai_cursor + k) % total;
+		if (update->tiers[i] != AI_NEAR_TIER && update->enemies[i].alive)
+			update->due[count++] = i;
+	}
+	if (total > 0)
+		*update->ai_cursor = (*update->ai_cursor + slice) % total;
+	update->due_count = count;
+	return (count);
+}
@@ -0,0 +1,79 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * scheduler_init - Points a scheduler at the weapon system's behaviours
+ * @scheduler: Scheduler to fill in
+ * @weapon_system: Pointer to weapon system
+ */
+void scheduler_init(Scheduler *scheduler, WeaponSystem *weapon_system)
+{
+	scheduler->behaviours = weapon_system->behaviours;
+	scheduler->count = MAX_ENEMIES;
+	scheduler->next = weapon_system->sched_next;
+	scheduler->prev = weapon_system->sched_prev;
+	scheduler->wheel = weapon_system->sched_wheel;
+	scheduler->ready = weapon_system->sched_ready;
+	scheduler->ready_count = &weapon_system->sched_ready_count;
+}
+
+/**
+ * start_behaviours - Gives every enemy a script and runs it to its first
+ * wait
+ * @weapon_system: Pointer to weapon system, with the enemies just spawned
+ *
+ * Scripts go round BEHAVIOUR_SCRIPTS by enemy index, so every level has
+ * the same mix of chasers, patrols, ambushers and skirmishers.
+ */
+void start_behaviours(WeaponSystem *weapon_system)
+{
+	Scheduler scheduler;
+	Behaviour *co;
+	int i;
+
+	scheduler_init(&scheduler, weapon_system);
+	for (i = 0; i < MAX_ENEMIES; i++)
+	{
+		co = &weapon_system->behaviours[i];
+		co->wake = 0;
+		co->line = 0;
+		co->script = i % BEHAVIOUR_SCRIPTS;
+		co->wait = BEHAVIOUR_START;
+	}
+	scheduler_reset(&scheduler);
+	for (i = 0; i < MAX_ENEMIES; i++)
+		scheduler_signal(&scheduler, i, BEHAVIOUR_START);
+	scheduler_run(&scheduler, weapon_system->enemies,
+		weapon_system->time / weapon_system->tick_ms, weapon_system->tick_ms);
+}
+
+/**
+ * resume_behaviours - Rebuilds the scheduler after its behaviours were
+ * loaded
+ * @weapon_system: Pointer to weapon system
+ */
+void resume_behaviours(WeaponSystem *weapon_system)
+{
+	Scheduler scheduler;
+
+	scheduler_init(&scheduler, weapon_system);
+	scheduler_reset(&scheduler);
+}
+
+/**
+ * update_behaviours - Resumes the enemy scripts due this tick
+ * @weapon_system: Pointer to weapon system
+ * Return: Number of scripts resumed
+ *
+ * Runs after the entity updates, whose merges signal the events of the
+ * tick; the modes the scripts set take effect on the next tick.
+ */
+int update_behaviours(WeaponSystem *weapon_system)
+{
+	Scheduler scheduler;
+
+	scheduler_init(&scheduler, weapon_system);
+	return (scheduler_run(&scheduler, weapon_system->enemies,
+		weapon_system->time / weapon_system->tick_ms,
+		weapon_system->tick_ms));
+}
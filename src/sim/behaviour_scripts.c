@@ -0,0 +1,129 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+#define PATROL_CELLS 4    /* Longest patrol leg, in cells */
+#define PATROL_PAUSE 1000 /* ms a patroller stands at each end */
+
+/**
+ * patrol_goal - Picks the far end of an enemy's patrol
+ * @enemy: Enemy, standing at the near end
+ *
+ * The goal is the farthest of up to PATROL_CELLS open cells in a
+ * straight line from the enemy's cell, trying +X, -X, +Y, -Y in turn.
+ * An enemy boxed in on all sides patrols on the spot.
+ */
+static void patrol_goal(Enemy *enemy)
+{
+	static const int steps[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+	int d, n, x, y, best = 0;
+
+	enemy->goal_x = enemy->x;
+	enemy->goal_y = enemy->y;
+	for (d = 0; d < 4; d++)
+	{
+		x = (int)enemy->x;
+		y = (int)enemy->y;
+		for (n = 0; n < PATROL_CELLS; n++)
+		{
+			x += steps[d][0];
+			y += steps[d][1];
+			if (x < 0 || y < 0 || x >= MAZE_COLS || y >= MAZE_ROWS ||
+				maze[y][x] != CELL_EMPTY)
+				break;
+		}
+		if (n <= best)
+			continue;
+		best = n;
+		enemy->goal_x = (int)enemy->x + steps[d][0] * n + 0.5f;
+		enemy->goal_y = (int)enemy->y + steps[d][1] * n + 0.5f;
+	}
+}
+
+/**
+ * chase - Chases the player whenever in sight; the game's original enemy
+ * @co: Coroutine state
+ * @enemy: Enemy
+ */
+static void chase(Behaviour *co, Enemy *enemy)
+{
+	CO_BEGIN(co);
+	enemy->mode = ENEMY_CHASE;
+	CO_END(co);
+}
+
+/**
+ * patrol - Walks between its spawn point and a cell nearby, pausing at
+ * each end, until the player comes near or shoots it; then chases
+ * @co: Coroutine state; keeps the end it walks back to
+ * @enemy: Enemy
+ *
+ * A leg that takes longer than PATROL_TIMEOUT, say because the enemy got
+ * caught on a corner, turns back early.
+ */
+static void patrol(Behaviour *co, Enemy *enemy)
+{
+	float x;
+
+	CO_BEGIN(co);
+	co->x = enemy->x;
+	co->y = enemy->y;
+	patrol_goal(enemy);
+	for (;;)
+	{
+		enemy->mode = ENEMY_GOTO;
+		CO_WAIT(co, BEHAVIOUR_ARRIVED | BEHAVIOUR_NEAR | BEHAVIOUR_HURT,
+			PATROL_TIMEOUT);
+		if (CO_WOKEN_BY(co, BEHAVIOUR_NEAR | BEHAVIOUR_HURT))
+			break;
+		enemy->mode = ENEMY_HOLD;
+		CO_WAIT(co, BEHAVIOUR_NEAR | BEHAVIOUR_HURT, PATROL_PAUSE);
+		if (CO_WOKEN_BY(co, BEHAVIOUR_NEAR | BEHAVIOUR_HURT))
+			break;
+		x = enemy->goal_x;
+		enemy->goal_x = co->x;
+		co->x = x;
+		x = enemy->goal_y;
+		enemy->goal_y = co->y;
+		co->y = x;
+	}
+	enemy->mode = ENEMY_CHASE;
+	CO_END(co);
+}
+
+/**
+ * ambush - Stands still until the player comes near or shoots it
+ * @co: Coroutine state
+ * @enemy: Enemy
+ */
+static void ambush(Behaviour *co, Enemy *enemy)
+{
+	CO_BEGIN(co);
+	enemy->mode = ENEMY_HOLD;
+	CO_WAIT(co, BEHAVIOUR_NEAR | BEHAVIOUR_HURT, 0);
+	enemy->mode = ENEMY_CHASE;
+	CO_END(co);
+}
+
+/**
+ * skirmish - Chases, and falls back for SKIRMISH_FALLBACK every time it
+ * is hit
+ * @co: Coroutine state
+ * @enemy: Enemy
+ */
+static void skirmish(Behaviour *co, Enemy *enemy)
+{
+	CO_BEGIN(co);
+	for (;;)
+	{
+		enemy->mode = ENEMY_CHASE;
+		CO_WAIT(co, BEHAVIOUR_HURT, 0);
+		enemy->mode = ENEMY_FLEE;
+		CO_SLEEP(co, SKIRMISH_FALLBACK);
+	}
+	CO_END(co);
+}
+
+/* Scripts by BEHAVIOUR_* number */
+const BehaviourScript behaviour_scripts[BEHAVIOUR_SCRIPTS] = {
+	chase, patrol, ambush, skirmish
+};
@@ -0,0 +1,82 @@
+#include "../../inc/net.h"
+
+/**
+ * bits_init - Starts reading or writing a packet buffer
+ * @bits: Bit stream to initialize
+ * @data: Packet bytes
+ * @size: Size of @data in bytes
+ * @writing: 1 to write, 0 to read
+ */
+void bits_init(Bits *bits, Uint8 *data, int size, int writing)
+{
+	bits->data = data;
+	bits->size = size;
+	bits->pos = 0;
+	bits->writing = writing;
+	bits->overflow = 0;
+}
+
+/**
+ * bits_write - Appends the low bits of a value
+ * @bits: Bit stream being written
+ * @value: Value to write
+ * @count: Number of bits, 1 to 32
+ */
+void bits_write(Bits *bits, Uint32 value, int count)
+{
+	Uint8 mask;
+
+	while (count-- > 0)
+	{
+		if (bits->pos >= bits->size * 8)
+		{
+			bits->overflow = 1;
+			return;
+		}
+		mask = 0x80 >> (bits->pos & 7);
+		if ((value >> count) & 1)
+			bits->data[bits->pos >> 3] |= mask;
+		else
+			bits->data[bits->pos >> 3] &= ~mask;
+		bits->pos++;
+	}
+}
+
+/**
+ * bits_read - Reads the next bits as an unsigned value
+ * @bits: Bit stream being read
+ * @count: Number of bits, 1 to 32
+ * Return: The value; bits past the end of the buffer read as 0
+ */
+Uint32 bits_read(Bits *bits, int count)
+{
+	Uint32 value = 0;
+
+	while (count-- > 0)
+	{
+		value <<= 1;
+		if (bits->pos >= bits->size * 8)
+			bits->overflow = 1;
+		else
+			value |= (bits->data[bits->pos >> 3] >> (7 - (bits->pos & 7))) & 1;
+		bits->pos++;
+	}
+	return (value);
+}
+
+/**
+ * bits_field - Writes a value when writing, reads one when reading
+ * @bits: Bit stream
+ * @value: Value to write; ignored when reading
+ * @count: Number of bits
+ * Return: The value written or read
+ *
+ * Lets one function describe a packet layout for both directions.
+ */
+Uint32 bits_field(Bits *bits, Uint32 value, int count)
+{
+	if (!bits->writing)
+		return (bits_read(bits, count));
+	bits_write(bits, value, count);
+	return (value);
+}
@@ -0,0 +1,32 @@
+#include "../../inc/input.h"
+
+/**
+ * bot_init - Starts a bot
+ * @bot: Bot to initialize
+ * @seed: Game seed; the bot derives a stream of its own from it
+ */
+void bot_init(Bot *bot, Uint32 seed)
+{
+	rng_seed(&bot->rng, seed ^ 0x9E3779B9u);
+	bot->held = 0;
+	bot->hold = 0;
+}
+
+/**
+ * bot_input - Picks the bot's input for the next tick
+ * @bot: Bot
+ * @input: Receives the input
+ *
+ * Holds a random mix of movement and turn buttons for 10 to 59 ticks at
+ * a time and fires on about a quarter of the ticks.
+ */
+void bot_input(Bot *bot, Input *input)
+{
+	if (--bot->hold <= 0)
+	{
+		bot->held = rng_next(&bot->rng) & BOT_MOVES;
+		bot->hold = 10 + rng_next(&bot->rng) % 50;
+	}
+	input->buttons = bot->held | (rng_next(&bot->rng) % 4 == 0 ?
+		INPUT_FIRE : 0);
+}
@@ -0,0 +1,119 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * create_bullet - Create a new bullet from player position
+ * @weapon_system: Pointer to weapon system
+ * @player: Pointer to player struct
+ */
+void create_bullet(WeaponSystem *weapon_system, Player *player)
+{
+	int i;
+	Uint32 current_time = weapon_system->time;
+
+	/* Implement shot cooldown */
+	if (current_time - weapon_system->last_shot_time < SHOT_COOLDOWN)
+		return;
+
+	/* Find an inactive bullet slot */
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		if (!weapon_system->bullets[i].active)
+		{
+			/* Initialize the bullet */
+			weapon_system->bullets[i].x = player->x;
+			weapon_system->bullets[i].y = player->y;
+			weapon_system->bullets[i].dx = player->dx;
+			weapon_system->bullets[i].dy = player->dy;
+			weapon_system->bullets[i].active = 1;
+			weapon_system->bullets[i].created = current_time;
+			lightmap_place(weapon_system->lightmap, i, player->x, player->y,
+				current_time + MUZZLE_FLASH_MS);
+
+			/* Update last shot time */
+			weapon_system->last_shot_time = current_time;
+			break;
+		}
+	}
+}
+
+/**
+ * update_bullet_lights - Moves muzzle flashes along with their bullets
+ * @weapon_system: Pointer to weapon system
+ *
+ * A flash follows its bullet for MUZZLE_FLASH_MS and goes out early if
+ * the bullet hits something; lightmap_expire() turns off the rest.
+ */
+static void update_bullet_lights(WeaponSystem *weapon_system)
+{
+	int i;
+	Bullet *bullet;
+
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		bullet = &weapon_system->bullets[i];
+		if (!bullet->active)
+			lightmap_remove(weapon_system->lightmap, i);
+		else if (weapon_system->time - bullet->created < MUZZLE_FLASH_MS)
+			lightmap_place(weapon_system->lightmap, i, bullet->x, bullet->y,
+				bullet->created + MUZZLE_FLASH_MS);
+	}
+}
+
+/**
+ * entity_update_init - Points an entity update at the weapon system
+ * @update: Entity update to fill in
+ * @weapon_system: Pointer to weapon system
+ * @player: Player the enemies chase
+ * @hits: Scratch of at least MAX_BULLETS entries
+ * @events: Scratch of at least MAX_ENEMIES entries
+ * @due: Scratch of at least MAX_ENEMIES entries
+ *
+ * No scheduler or enemy grid is attached; the weapon system's own
+ * updates attach them, so their merges wake the enemies' scripts.
+ */
+void entity_update_init(EntityUpdate *update, WeaponSystem *weapon_system,
+		const Player *player, BulletHit *hits, Uint8 *events,
+		int *due)
+{
+	update->enemies = weapon_system->enemies;
+	update->enemy_total = MAX_ENEMIES;
+	update->bullets = weapon_system->bullets;
+	update->bullet_total = MAX_BULLETS;
+	update->player = player;
+	update->pvs = &weapon_system->pvs;
+	update->time = weapon_system->time;
+	update->tick_ms = weapon_system->tick_ms;
+	update->hits = hits;
+	update->events = events;
+	update->due = due;
+	update->due_count = 0;
+	update->tiers = weapon_system->ai_tier;
+	update->ai_cursor = &weapon_system->ai_cursor;
+	update->score = &weapon_system->score;
+	update->enemy_count = &weapon_system->enemy_count;
+	update->player_health = &weapon_system->player_health;
+	update->scheduler = NULL;
+	update->grid = NULL;
+}
+
+/**
+ * update_bullets - Move bullets and check for collisions
+ * @weapon_system: Pointer to weapon system
+ */
+void update_bullets(WeaponSystem *weapon_system)
+{
+	EntityUpdate update;
+	Scheduler scheduler;
+	BulletHit hits[MAX_BULLETS];
+	EnemyGrid grid;
+	int grid_enemies[4 * MAX_ENEMIES];
+
+	entity_update_init(&update, weapon_system, NULL, hits, NULL, NULL);
+	scheduler_init(&scheduler, weapon_system);
+	update.scheduler = &scheduler;
+	grid.enemies = grid_enemies;
+	update.grid = &grid;
+	entities_update_bullets(&update, weapon_system->jobs);
+	update_bullet_lights(weapon_system);
+}
@@ -0,0 +1,150 @@
+#include "../../inc/net.h"
+#include <string.h>
+
+/**
+ * client_start - Opens a socket for talking to a server
+ * @client: Client to initialize
+ * @address: Server address, "a.b.c.d:port" or a port on this machine
+ * Return: 0 on success, -1 on failure
+ *
+ * There is no handshake: the server adds the client when its first
+ * packet arrives.
+ */
+int client_start(Client *client, const char *address)
+{
+	int port = 0;
+
+	memset(client, 0, sizeof(*client));
+	client->socket = -1;
+	if (udp_resolve(address, &client->server) != 0)
+	{
+		printf("Bad server address %s\n", address);
+		return (-1);
+	}
+	client->socket = udp_open(&port);
+	return (client->socket < 0 ? -1 : 0);
+}
+
+/**
+ * client_receive - Decodes every snapshot that has arrived
+ * @client: Client
+ * @now: SDL_GetTicks() time
+ * Return: Number of new snapshots
+ *
+ * Snapshots older than the newest one, or encoded against one the client
+ * does not have, are dropped; the server falls back to a full snapshot
+ * once the client's acknowledgements stop matching its history.
+ */
+int client_receive(Client *client, Uint32 now)
+{
+	static const Snapshot empty;
+	Uint8 data[NET_PACKET_MAX];
+	struct sockaddr_in from;
+	const Snapshot *base;
+	Snapshot snapshot;
+	Uint32 tick, base_tick, tick_ms;
+	Bits bits;
+	int size, count = 0;
+
+	while ((size = udp_receive(client->socket, &from, data,
+		sizeof(data))) >= 0)
+	{
+		bits_init(&bits, data, size, 0);
+		if (from.sin_port != client->server.sin_port ||
+			bits_read(&bits, 8) != NET_PACKET_SERVER)
+			continue;
+		tick = bits_read(&bits, 32);
+		base_tick = bits_read(&bits, 32);
+		tick_ms = bits_read(&bits, 16);
+		base = base_tick ? &client->history[base_tick & (NET_HISTORY - 1)] :
+			&empty;
+		if (tick <= client->latest || tick_ms == 0 ||
+			(base_tick && base->tick != base_tick) ||
+			snapshot_decode(&bits, base, &snapshot) != 0)
+			continue;
+		snapshot.tick = tick;
+		memcpy(&client->history[tick & (NET_HISTORY - 1)], &snapshot,
+			sizeof(snapshot));
+		client->latest = tick;
+		client->arrived = now;
+		client->tick_ms = tick_ms;
+		client->bytes += size;
+		count++;
+	}
+	return (count);
+}
+
+/**
+ * client_send - Sends the buttons held this tick and acknowledges
+ * @client: Client
+ * @input: Buttons held; the server ignores them from spectators
+ *
+ * Sent once per local tick, which also keeps the client from timing out.
+ */
+void client_send(Client *client, const Input *input)
+{
+	Uint8 data[6];
+	Bits bits;
+
+	bits_init(&bits, data, sizeof(data), 1);
+	bits_write(&bits, NET_PACKET_CLIENT, 8);
+	bits_write(&bits, input->buttons, 8);
+	bits_write(&bits, client->latest, 32);
+	udp_send(client->socket, &client->server, data, BITS_BYTES(&bits));
+}
+
+/**
+ * client_sample - Sets up the world to draw at the current time
+ * @client: Client
+ * @now: SDL_GetTicks() time
+ * @game_state: Receives the tick
+ * @player: Receives the player
+ * @weapon_system: Receives enemies, bullets and the HUD values
+ * Return: 0 on success, -1 before the first snapshot has arrived
+ *
+ * Shows the world NET_INTERP_TICKS behind the newest snapshot, between
+ * the two received snapshots around that time. Snapshots lost on the
+ * way are bridged by interpolating over the gap; if none are new enough
+ * the newest is shown as is.
+ */
+int client_sample(const Client *client, Uint32 now, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system)
+{
+	const Snapshot *history = client->history, *a, *b;
+	Uint32 tick, next;
+	float target;
+
+	if (!client->latest)
+		return (-1);
+	target = (float)client->latest - NET_INTERP_TICKS +
+		(float)(now - client->arrived) / client->tick_ms;
+	b = &history[client->latest & (NET_HISTORY - 1)];
+	tick = target < 1 ? 0 : (Uint32)target;
+	while (tick > 0 && tick + NET_HISTORY > client->latest &&
+		history[tick & (NET_HISTORY - 1)].tick != tick)
+		tick--;
+	a = &history[tick & (NET_HISTORY - 1)];
+	if (target >= client->latest || tick == 0 || a->tick != tick)
+	{
+		snapshot_apply(b, client->tick_ms, game_state, player, weapon_system);
+		return (0);
+	}
+	for (next = tick + 1; history[next & (NET_HISTORY - 1)].tick != next;
+		next++)
+		;
+	b = &history[next & (NET_HISTORY - 1)];
+	snapshot_apply(a, client->tick_ms, game_state, player, weapon_system);
+	snapshot_lerp(a, b, (target - a->tick) / (b->tick - a->tick), player,
+		weapon_system);
+	return (0);
+}
+
+/**
+ * client_stop - Closes the client socket
+ * @client: Client
+ */
+void client_stop(Client *client)
+{
+	udp_close(client->socket);
+	client->socket = -1;
+}
@@ -0,0 +1,48 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * check_collision - Checks if a position collides with a wall
+ * @maze: 2D maze array
+ * @x: X position to check
+ * @y: Y position to check
+ * Return: 1 if collision, 0 if no collision
+ */
+int check_collision(const int maze[15][15], float x, float y)
+{
+	const float buffer = 0.08; /* Buffer for wall collision */
+
+	return (cell_blocks(maze, (int)(x + buffer), (int)(y + buffer)) ||
+		cell_blocks(maze, (int)(x - buffer), (int)(y - buffer)) ||
+		cell_blocks(maze, (int)(x - buffer), (int)(y + buffer)) ||
+		cell_blocks(maze, (int)(x + buffer), (int)(y - buffer)));
+}
+
+/**
+ * has_line_of_sight - Check if there's clear line of sight betwn 2 points
+ * @start_x: Starting X position
+ * @start_y: Starting Y position
+ * @end_x: Ending X position
+ * @end_y: Ending Y position
+ * Return: 1 if clear LOS, 0 if blocked by a wall
+ */
+int has_line_of_sight(float start_x, float start_y, float end_x, float end_y)
+{
+float dx = end_x - start_x;
+float dy = end_y - start_y;
+/* Number of steps to check */
+float steps = fabsf(dx) > fabsf(dy) ? fabsf(dx) : fabsf(dy);
+float x_increment = dx / (steps > 0 ? steps : 1);
+float y_increment = dy / (steps > 0 ? steps : 1);
+float x = start_x;
+float y = start_y;
+
+for (int i = 0; i <= (int)steps; i++)
+{
+	if (check_collision(maze, x, y))
+		return (0); /* Wall detected, no LOS */
+	x += x_increment;
+	y += y_increment;
+}
+return (1); /* Clear LOS */
+}
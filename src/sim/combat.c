@@ -0,0 +1,90 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * init_weapon_system - Initialize the weapon system
+ * @weapon_system: Pointer to weapon system
+ * @maze: The maze array
+ * @rng: Game random number generator
+ * Return: 1 on success, 0 on failure
+ */
+int init_weapon_system(WeaponSystem *weapon_system, const int maze[15][15],
+		Rng *rng)
+{
+	int i;
+
+	if (!weapon_system)
+		return (0);
+
+	/* Initialize weapon system state */
+	weapon_system->enemy_count = 0;
+	weapon_system->score = 0;
+	weapon_system->player_health = 100;
+	weapon_system->last_shot_time = 0;
+	weapon_system->time = 0;
+	weapon_system->tick_ms = TICK_MS;
+	weapon_system->lightmap = NULL;
+	pvs_build(&weapon_system->pvs, maze);
+	doors_reset();
+
+	/* Initialize bullets */
+	for (i = 0; i < MAX_BULLETS; i++)
+		weapon_system->bullets[i].active = 0;
+
+	/* Initialize enemies */
+	init_enemies(weapon_system, maze, rng);
+
+	return (1);
+}
+
+/**
+ * handle_shooting - Handle player shooting
+ * @weapon_system: Pointer to weapon system
+ * @player: Pointer to player struct
+ * @input: Buttons held during this tick
+ */
+void handle_shooting(WeaponSystem *weapon_system, Player *player,
+		   const Input *input)
+{
+	if (input->buttons & INPUT_FIRE)
+		create_bullet(weapon_system, player);
+}
+
+/**
+ * update_weapon_system - Update all weapon system elements
+ * @weapon_system: Pointer to weapon system
+ * @player: Pointer to player struct
+ * @input: Buttons held during this tick
+ * @maze: The maze array
+ * @rng: Game random number generator
+ */
+void update_weapon_system(WeaponSystem *weapon_system, Player *player,
+			const Input *input, const int maze[15][15], Rng *rng)
+{
+	lightmap_expire(weapon_system->lightmap, weapon_system->time);
+
+	/* Handle player shooting */
+	handle_shooting(weapon_system, player, input);
+
+	/* Update bullets */
+	update_bullets(weapon_system);
+
+	/* Update enemies */
+	update_enemies(weapon_system, player);
+
+	/* Resume the behaviour scripts woken by this tick's events */
+	update_behaviours(weapon_system);
+
+	/* Check for game over or level complete conditions */
+	if (weapon_system->enemy_count <= 0)
+	{
+		/* All enemies defeated - level complete */
+		init_enemies(weapon_system, maze, rng);
+	}
+
+	if (weapon_system->player_health <= 0)
+	{
+		/* Player defeated - game over */
+		weapon_system->player_health = 100;  /* Reset for demo purposes */
+	}
+}
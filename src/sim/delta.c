@@ -0,0 +1,130 @@
+#include "../../inc/net.h"
+#include <string.h>
+
+/**
+ * code_player - Writes or reads the player and HUD fields of a snapshot
+ * @bits: Bit stream
+ * @base: Snapshot the client already has
+ * @snapshot: Snapshot being written, or a copy of @base being read into
+ *
+ * Each group of fields is preceded by a dirty bit and only follows it
+ * when it differs from @base.
+ */
+static void code_player(Bits *bits, const Snapshot *base, Snapshot *snapshot)
+{
+	int i;
+
+	if (bits_field(bits, snapshot->x != base->x || snapshot->y != base->y, 1))
+	{
+		snapshot->x = bits_field(bits, snapshot->x, NET_POS_BITS);
+		snapshot->y = bits_field(bits, snapshot->y, NET_POS_BITS);
+	}
+	if (bits_field(bits, snapshot->angle != base->angle, 1))
+		snapshot->angle = bits_field(bits, snapshot->angle, NET_ANGLE_BITS);
+	if (bits_field(bits, snapshot->score != base->score, 1))
+		snapshot->score = bits_field(bits, snapshot->score, 32);
+	if (bits_field(bits, snapshot->health != base->health ||
+		snapshot->enemy_count != base->enemy_count, 1))
+	{
+		snapshot->health = bits_field(bits, snapshot->health, 8);
+		snapshot->enemy_count = bits_field(bits, snapshot->enemy_count, 8);
+	}
+	if (bits_field(bits, snapshot->shot_age != base->shot_age, 1))
+		snapshot->shot_age = bits_field(bits, snapshot->shot_age,
+			NET_AGE_BITS);
+	for (i = 0; i < NET_MAX_DOORS; i++)
+		if (bits_field(bits, snapshot->doors[i] != base->doors[i], 1))
+			snapshot->doors[i] = bits_field(bits, snapshot->doors[i], 8);
+}
+
+/**
+ * code_entities - Writes or reads the enemies and bullets of a snapshot
+ * @bits: Bit stream
+ * @base: Snapshot the client already has
+ * @snapshot: Snapshot being written, or a copy of @base being read into
+ *
+ * An unchanged entity costs one bit. A changed one has a dirty bit per
+ * field: position, health and attack age for enemies, position for
+ * bullets. The position of an inactive bullet is never sent.
+ */
+static void code_entities(Bits *bits, const Snapshot *base,
+		Snapshot *snapshot)
+{
+	const NetEnemy *old_enemy;
+	const NetBullet *old_bullet;
+	NetEnemy *enemy;
+	NetBullet *bullet;
+	int i;
+
+	for (i = 0; i < MAX_ENEMIES; i++)
+	{
+		old_enemy = &base->enemies[i];
+		enemy = &snapshot->enemies[i];
+		if (!bits_field(bits, enemy->x != old_enemy->x ||
+			enemy->y != old_enemy->y || enemy->alive != old_enemy->alive ||
+			enemy->health != old_enemy->health ||
+			enemy->attack_age != old_enemy->attack_age, 1))
+			continue;
+		enemy->alive = bits_field(bits, enemy->alive, 1);
+		if (bits_field(bits, enemy->x != old_enemy->x ||
+			enemy->y != old_enemy->y, 1))
+		{
+			enemy->x = bits_field(bits, enemy->x, NET_POS_BITS);
+			enemy->y = bits_field(bits, enemy->y, NET_POS_BITS);
+		}
+		if (bits_field(bits, enemy->health != old_enemy->health, 1))
+			enemy->health = bits_field(bits, enemy->health, 8);
+		if (bits_field(bits, enemy->attack_age != old_enemy->attack_age, 1))
+			enemy->attack_age = bits_field(bits, enemy->attack_age,
+				NET_AGE_BITS);
+	}
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		old_bullet = &base->bullets[i];
+		bullet = &snapshot->bullets[i];
+		if (!bits_field(bits, bullet->x != old_bullet->x ||
+			bullet->y != old_bullet->y ||
+			bullet->active != old_bullet->active, 1))
+			continue;
+		bullet->active = bits_field(bits, bullet->active, 1);
+		if (bullet->active && bits_field(bits, bullet->x != old_bullet->x ||
+			bullet->y != old_bullet->y, 1))
+		{
+			bullet->x = bits_field(bits, bullet->x, NET_POS_BITS);
+			bullet->y = bits_field(bits, bullet->y, NET_POS_BITS);
+		}
+		else if (!bullet->active)
+			bullet->x = bullet->y = 0;
+	}
+}
+
+/**
+ * snapshot_encode - Writes a snapshot as a delta against another
+ * @bits: Bit stream being written
+ * @base: Snapshot the client already has; all zeros for a full snapshot
+ * @snapshot: Snapshot to send
+ */
+void snapshot_encode(Bits *bits, const Snapshot *base,
+		const Snapshot *snapshot)
+{
+	Snapshot copy;
+
+	memcpy(&copy, snapshot, sizeof(copy));
+	code_player(bits, base, &copy);
+	code_entities(bits, base, &copy);
+}
+
+/**
+ * snapshot_decode - Rebuilds a snapshot from a delta
+ * @bits: Bit stream being read
+ * @base: Snapshot the delta was encoded against
+ * @snapshot: Receives the snapshot; its tick is left to the caller
+ * Return: 0 on success, -1 if the packet was cut short
+ */
+int snapshot_decode(Bits *bits, const Snapshot *base, Snapshot *snapshot)
+{
+	memcpy(snapshot, base, sizeof(*snapshot));
+	code_player(bits, base, snapshot);
+	code_entities(bits, base, snapshot);
+	return (bits->overflow ? -1 : 0);
+}
@@ -0,0 +1,52 @@
+#include "../../inc/maze.h"
+#include <string.h>
+
+/* How far each door cell is open, 0 (closed) to DOOR_OPEN */
+Uint8 door_open[MAZE_ROWS][MAZE_COLS];
+
+/**
+ * doors_reset - Closes every door
+ */
+void doors_reset(void)
+{
+	memset(door_open, 0, sizeof(door_open));
+}
+
+/**
+ * doors_update - Opens doors near the player and closes the rest
+ * @player: Player whose distance opens doors
+ * @tick_ms: Length of the simulation tick
+ */
+void doors_update(const Player *player, Uint32 tick_ms)
+{
+	int x, y, amount, speed = DOOR_SPEED * tick_ms / TICK_MS;
+	float dx, dy;
+
+	for (y = 0; y < MAZE_ROWS; y++)
+		for (x = 0; x < MAZE_COLS; x++)
+		{
+			if (maze[y][x] != CELL_DOOR)
+				continue;
+			dx = x + 0.5f - player->x;
+			dy = y + 0.5f - player->y;
+			amount = door_open[y][x];
+			amount += dx * dx + dy * dy < DOOR_RANGE * DOOR_RANGE ?
+				speed : -speed;
+			door_open[y][x] = amount < 0 ? 0 :
+				amount > DOOR_OPEN ? DOOR_OPEN : amount;
+		}
+}
+
+/**
+ * cell_blocks - Checks whether a cell stops movement
+ * @maze: Maze layout
+ * @x: Cell column
+ * @y: Cell row
+ * Return: 1 for walls, grates and doors that are not open enough
+ */
+int cell_blocks(const int maze[15][15], int x, int y)
+{
+	if (maze[y][x] == CELL_DOOR)
+		return (door_open[y][x] < DOOR_PASSABLE);
+	return (maze[y][x] != CELL_EMPTY);
+}
@@ -0,0 +1,63 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * init_enemies - Initialize enemies in the maze
+ * @weapon_system: Pointer to weapon system
+ * @maze: The maze array
+ * @rng: Game random number generator
+ */
+void init_enemies(WeaponSystem *weapon_system, const int maze[15][15],
+Rng *rng)
+{
+int i, x, y;
+
+weapon_system->enemy_count = 0;
+weapon_system->ai_cursor = 0;
+
+for (i = 0; i < MAX_ENEMIES; i++)
+{
+	do {
+		x = rng_next(rng) % 15;
+		y = rng_next(rng) % 15;
+	} while (maze[y][x] != 0 || (x == 1 && y == 1));
+
+	weapon_system->enemies[i].x = (float)x + 0.5f;
+	weapon_system->enemies[i].y = (float)y + 0.5f;
+	weapon_system->enemies[i].alive = 1;
+	weapon_system->enemies[i].health = 100.0f;
+	weapon_system->enemies[i].speed = 0.03f + rng_float(rng) * 0.02f;
+	weapon_system->enemies[i].last_attack = 0;
+	weapon_system->enemies[i].direction = 0;
+	weapon_system->enemies[i].thought = weapon_system->time;
+	weapon_system->enemies[i].mode = ENEMY_CHASE;
+	weapon_system->enemies[i].goal_x = weapon_system->enemies[i].x;
+	weapon_system->enemies[i].goal_y = weapon_system->enemies[i].y;
+	weapon_system->ai_tier[i] = AI_FAR_TIER;
+
+	weapon_system->enemy_count++;
+}
+start_behaviours(weapon_system);
+}
+
+/**
+ * update_enemies - Move enemies as their behaviour scripts say
+ * @weapon_system: Pointer to weapon system
+ * @player: Pointer to player struct
+ *
+ * Near enemies think every tick and the rest in round-robin slices;
+ * enemies that cannot possibly see the player hold their position
+ * unless their script sent them somewhere.
+ */
+void update_enemies(WeaponSystem *weapon_system, Player *player)
+{
+EntityUpdate update;
+Scheduler scheduler;
+Uint8 events[MAX_ENEMIES];
+int due[MAX_ENEMIES];
+
+entity_update_init(&update, weapon_system, player, NULL, events, due);
+scheduler_init(&scheduler, weapon_system);
+update.scheduler = &scheduler;
+entities_update_enemies(&update, weapon_system->jobs);
+}
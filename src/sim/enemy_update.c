@@ -0,0 +1,165 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * enemy_heading - Works out which way an enemy moves this update
+ * @enemy: Enemy; turned to face where it is going or the player
+ * @dx: In, X from the enemy to the player; out, X of the heading
+ * @dy: In, Y from the enemy to the player; out, Y of the heading
+ * @length: Distance to the player
+ * @events: Receives BEHAVIOUR_ARRIVED if the enemy reached its goal
+ * Return: 1 if the enemy moves along the heading, 0 if it holds still
+ *
+ * Only ENEMY_GOTO works without the player in sight.
+ */
+static int enemy_heading(Enemy *enemy, float *dx, float *dy, float length,
+		Uint8 *events)
+{
+	float gx, gy, distance;
+
+	if (enemy->mode == ENEMY_GOTO)
+	{
+		gx = enemy->goal_x - enemy->x;
+		gy = enemy->goal_y - enemy->y;
+		distance = sqrtf(gx * gx + gy * gy);
+		if (distance < ARRIVE_RADIUS)
+		{
+			*events |= BEHAVIOUR_ARRIVED;
+			return (0);
+		}
+		*dx = gx / distance;
+		*dy = gy / distance;
+		enemy->direction = atan2f(*dy, *dx);
+		return (1);
+	}
+	if (length > 0)
+	{
+		*dx /= length;
+		*dy /= length;
+		enemy->direction = atan2f(*dy, *dx);
+	}
+	if (enemy->mode == ENEMY_FLEE)
+	{
+		*dx = -*dx;
+		*dy = -*dy;
+	}
+	return (enemy->mode != ENEMY_HOLD);
+}
+
+/**
+ * enemy_move - Moves an enemy for the time since its last update
+ * @enemy: Enemy to move
+ * @player: Player the heading is worked out from
+ * @elapsed: Milliseconds to move for
+ * @events: Receives BEHAVIOUR_ARRIVED if the enemy reaches its goal
+ *
+ * The time is covered in steps of at most AI_MAX_STEP_MS, each turning
+ * towards the player or goal again and checking the walls, so a far
+ * enemy that runs once every many ticks travels as far as a near one
+ * without a single step crossing a wall.
+ */
+static void enemy_move(Enemy *enemy, const Player *player, Uint32 elapsed,
+		Uint8 *events)
+{
+	float dx, dy, length, speed, new_x, new_y;
+	Uint32 step;
+
+	do {
+		step = elapsed < AI_MAX_STEP_MS ? elapsed : AI_MAX_STEP_MS;
+		elapsed -= step;
+		dx = player->x - enemy->x;
+		dy = player->y - enemy->y;
+		length = sqrtf(dx * dx + dy * dy);
+		if (!enemy_heading(enemy, &dx, &dy, length, events))
+			return;
+		speed = enemy->speed * step / TICK_MS;
+		new_x = enemy->x + dx * speed;
+		new_y = enemy->y + dy * speed;
+		if (!check_collision(maze, new_x, enemy->y))
+			enemy->x = new_x;
+		if (!check_collision(maze, enemy->x, new_y))
+			enemy->y = new_y;
+	} while (elapsed > 0);
+}
+
+/**
+ * enemies_chunk - Moves the due enemies [begin, end) as their mode says
+ * @context: Entity update
+ * @begin: First entry of the due list
+ * @end: One past the last entry
+ *
+ * Enemies that cannot possibly see the player hold their position unless
+ * they are heading for a goal. The others move for the time since their
+ * last update and are put back in the tier their distance calls for.
+ * Coming into the near tier raises BEHAVIOUR_NEAR for the enemy's script.
+ */
+static void enemies_chunk(void *context, int begin, int end)
+{
+	EntityUpdate *update = context;
+	const Player *player = update->player;
+	Enemy *enemy;
+	float dx, dy, length;
+	Uint32 elapsed;
+	int i, k, seen, was_near;
+
+	for (k = begin; k < end; k++)
+	{
+		i = update->due[k];
+		enemy = &update->enemies[i];
+		update->events[k] = 0;
+		elapsed = update->time - enemy->thought;
+		enemy->thought = update->time;
+		was_near = update->tiers[i] == AI_NEAR_TIER;
+		update->tiers[i] = AI_FAR_TIER;
+		seen = pvs_visible(update->pvs, enemy->x, enemy->y, player->x,
+			player->y);
+		if (!seen && enemy->mode != ENEMY_GOTO)
+			continue;
+		dx = player->x - enemy->x;
+		dy = player->y - enemy->y;
+		length = sqrtf(dx * dx + dy * dy);
+		enemy_move(enemy, player, elapsed, &update->events[k]);
+		if (seen && length < AI_NEAR)
+		{
+			update->tiers[i] = AI_NEAR_TIER;
+			if (!was_near)
+				update->events[k] |= BEHAVIOUR_NEAR;
+		}
+		if (enemy->mode == ENEMY_CHASE && length < 1.5f &&
+			update->time - enemy->last_attack > 1000)
+		{
+			update->events[k] |= ENEMY_ATTACKS;
+			enemy->last_attack = update->time;
+		}
+	}
+}
+
+/**
+ * entities_update_enemies - Moves enemies, applies their attacks and
+ * signals their events
+ * @update: Entity update
+ * @jobs: Thread pool, or NULL to run inline
+ * Return: Number of enemies that ran their AI this tick
+ *
+ * ai_schedule() picks the enemies to run serially first, so the result
+ * stays the same for any number of threads.
+ */
+int entities_update_enemies(EntityUpdate *update, JobPool *jobs)
+{
+	Uint8 events;
+	int k;
+
+	ai_schedule(update);
+	job_pool_run(jobs, enemies_chunk, update, update->due_count,
+		ENTITY_CHUNK);
+	for (k = 0; k < update->due_count; k++)
+	{
+		events = update->events[k];
+		if (events & ENEMY_ATTACKS)
+			*update->player_health -= 10;
+		events &= ~ENEMY_ATTACKS;
+		if (events && update->scheduler)
+			scheduler_signal(update->scheduler, update->due[k], events);
+	}
+	return (update->due_count);
+}
@@ -0,0 +1,197 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+#include <string.h>
+
+/**
+ * enemy_grid_build - Buckets the living enemies by the cells they touch
+ * @update: Entity update whose grid is rebuilt
+ *
+ * A counting sort: one pass counts each bucket, one places the enemies.
+ * Enemies go in ascending order, so every bucket is sorted.
+ */
+static void enemy_grid_build(EntityUpdate *update)
+{
+	EnemyGrid *grid = update->grid;
+	const Enemy *enemy;
+	int next[ENEMY_GRID_CELLS], pass, j, x, y, cell;
+
+	memset(grid->start, 0, sizeof(grid->start));
+	for (pass = 0; pass < 2; pass++)
+	{
+		for (j = 0; j < update->enemy_total; j++)
+		{
+			enemy = &update->enemies[j];
+			if (!enemy->alive)
+				continue;
+			for (y = (int)floorf(enemy->y - ENEMY_RADIUS);
+				y <= (int)floorf(enemy->y + ENEMY_RADIUS); y++)
+				for (x = (int)floorf(enemy->x - ENEMY_RADIUS);
+					x <= (int)floorf(enemy->x + ENEMY_RADIUS); x++)
+				{
+					if (x < 0 || y < 0 || x >= MAZE_COLS || y >= MAZE_ROWS)
+						continue;
+					cell = y * MAZE_COLS + x;
+					if (pass == 0)
+						grid->start[cell + 1]++;
+					else
+						grid->enemies[next[cell]++] = j;
+				}
+		}
+		for (cell = 0; pass == 0 && cell < ENEMY_GRID_CELLS; cell++)
+		{
+			grid->start[cell + 1] += grid->start[cell];
+			next[cell] = grid->start[cell];
+		}
+	}
+}
+
+/**
+ * bucket_hit - Sweeps a bullet's path against the enemies of one cell
+ * @update: Entity update
+ * @cell: Cell whose bucket is tested
+ * @path: Start (x, y), end (x, y) and length of the path
+ * @first: Earliest contact so far, lowered on a nearer hit
+ * @hit: Enemy of @first, or -1
+ *
+ * Enemies whose center projects more than ENEMY_RADIUS before the start
+ * or past the end of the path are rejected before the sweep.
+ */
+static void bucket_hit(const EntityUpdate *update, int cell,
+		const float *path, float *first, int *hit)
+{
+	const Enemy *enemy;
+	float dx = path[2] - path[0], dy = path[3] - path[1], along, t;
+	int i, j;
+
+	for (i = update->grid->start[cell]; i < update->grid->start[cell + 1];
+		i++)
+	{
+		j = update->grid->enemies[i];
+		enemy = &update->enemies[j];
+		along = (enemy->x - path[0]) * dx + (enemy->y - path[1]) * dy;
+		if (!enemy->alive || along < -ENEMY_RADIUS * path[4] ||
+			along > (path[4] + ENEMY_RADIUS) * path[4])
+			continue;
+		t = sweep_circle(path[0], path[1], path[2], path[3], enemy->x,
+			enemy->y, ENEMY_RADIUS);
+		if (t < *first || (t == *first && t < SWEEP_CLEAR && j < *hit))
+		{
+			*first = t;
+			*hit = j;
+		}
+	}
+}
+
+/**
+ * bullet_hit - Finds the first living enemy a bullet's path touches
+ * @update: Entity update, with its enemy grid built
+ * @x0: Start of the path, X
+ * @y0: Start of the path, Y
+ * @x1: End of the path, X
+ * @y1: End of the path, Y
+ * Return: Index of the enemy hit earliest along the path, or -1
+ *
+ * Only the buckets of the cells the path crosses are swept; an enemy
+ * the path touches overlaps one of them. Ties go to the lower index.
+ */
+static int bullet_hit(const EntityUpdate *update, float x0, float y0,
+		float x1, float y1)
+{
+	float path[5] = {x0, y0, x1, y1, 0}, first = SWEEP_CLEAR;
+	int cells[SWEEP_CELLS], count, i, hit = -1;
+
+	path[4] = sqrtf((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+	count = sweep_cells(x0, y0, x1, y1, cells);
+	for (i = 0; i < count; i++)
+		bucket_hit(update, cells[i], path, &first, &hit);
+	return (hit);
+}
+
+/**
+ * bullets_chunk - Moves bullets [begin, end) and finds what they hit
+ * @context: Entity update
+ * @begin: First bullet
+ * @end: One past the last bullet
+ *
+ * A bullet sweeps the whole segment it travels this tick, stopping at
+ * the first wall, so it cannot pass through a corner or an enemy however
+ * far it moves per tick.
+ */
+static void bullets_chunk(void *context, int begin, int end)
+{
+	EntityUpdate *update = context;
+	const float speed = BULLET_SPEED * update->tick_ms / TICK_MS;
+	Bullet *bullet;
+	BulletHit *hit;
+	float x1, y1, wall;
+	int i;
+
+	for (i = begin; i < end; i++)
+	{
+		bullet = &update->bullets[i];
+		hit = &update->hits[i];
+		hit->enemy = -1;
+		if (!bullet->active)
+			continue;
+		hit->x = bullet->x;
+		hit->y = bullet->y;
+		x1 = bullet->x + bullet->dx * speed;
+		y1 = bullet->y + bullet->dy * speed;
+		wall = sweep_walls(maze, bullet->x, bullet->y, x1, y1);
+		if (wall > 1.0f && check_collision(maze, x1, y1))
+			wall = 1.0f; /* Grazing a wall within the collision buffer */
+		if (wall <= 1.0f)
+		{
+			x1 = bullet->x + (x1 - bullet->x) * wall;
+			y1 = bullet->y + (y1 - bullet->y) * wall;
+			bullet->active = 0;
+		}
+		bullet->x = x1;
+		bullet->y = y1;
+		hit->enemy = bullet_hit(update, hit->x, hit->y, x1, y1);
+		if (update->time - bullet->created > 3000)
+			bullet->active = 0; /* Deactivate bullets after 3sec */
+	}
+}
+
+/**
+ * entities_update_bullets - Moves bullets and applies their hits
+ * @update: Entity update
+ * @jobs: Thread pool, or NULL to run inline
+ *
+ * The enemy grid is built first and holds for the whole update. Enemies
+ * only die during the merge, so a bullet whose target was killed by a
+ * bullet earlier in the array sweeps its path again for the next enemy,
+ * exactly as the serial loop would; dead enemies are skipped in the grid.
+ */
+void entities_update_bullets(EntityUpdate *update, JobPool *jobs)
+{
+	Enemy *enemy;
+	BulletHit *hit;
+	int i, j;
+
+	enemy_grid_build(update);
+	job_pool_run(jobs, bullets_chunk, update, update->bullet_total,
+		ENTITY_CHUNK);
+	for (i = 0; i < update->bullet_total; i++)
+	{
+		hit = &update->hits[i];
+		j = hit->enemy;
+		if (j >= 0 && !update->enemies[j].alive)
+			j = bullet_hit(update, hit->x, hit->y, update->bullets[i].x,
+				update->bullets[i].y);
+		if (j < 0)
+			continue;
+		enemy = &update->enemies[j];
+		enemy->health -= 50.0f; /* Damage enemy */
+		if (update->scheduler)
+			scheduler_signal(update->scheduler, j, BEHAVIOUR_HURT);
+		if (enemy->health <= 0) /* Check if enemy is killed */
+		{
+			enemy->alive = 0;
+			*update->score += 100;
+			(*update->enemy_count)--;
+		}
+		update->bullets[i].active = 0; /* Deactivate bullet */
+	}
+}
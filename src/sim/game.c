@@ -0,0 +1,108 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * game_init - Starts a new game from a seed
+ * @game_state: Pointer to the GameState structure
+ * @player: Player, placed at the start of the maze
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * @seed: Seed of the game RNG
+ *
+ * Sets up simulation state only; renderers attach their lightmap, sprites
+ * and threads afterwards.
+ */
+void game_init(GameState *game_state, Player *player,
+		WeaponSystem *weapon_system, Uint32 seed)
+{
+	rng_seed(&game_state->rng, seed);
+	game_state->tick = 0;
+	init_player(player, 1.5, 1.5, 0);
+	init_weapon_system(weapon_system, maze, &game_state->rng);
+}
+
+/**
+ * step_game - Runs one fixed-length simulation tick
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * @replay: Supplies the tick's input when playing, records it otherwise
+ * @live: Input from the player, used unless a replay is playing
+ * Return: 0 on success, -1 when a replay has run out of input
+ *
+ * Everything the simulation reads comes from the Input, the game RNG and
+ * the tick counter, so the same seed and input stream give the same state.
+ */
+int step_game(GameState *game_state, Player *player,
+		WeaponSystem *weapon_system, Replay *replay, const Input *live)
+{
+	Input input = *live;
+
+	if (replay->mode == REPLAY_PLAY)
+	{
+		if (replay_play(replay, &input) != 0)
+			return (-1);
+	}
+	else
+		replay_record(replay, &input);
+	game_state->input = input;
+	game_state->tick++;
+	weapon_system->tick_ms = replay->tick_ms;
+	weapon_system->time = game_state->tick * replay->tick_ms;
+
+	doors_update(player, replay->tick_ms);
+	update_player(player, &input, maze,
+		(float)replay->tick_ms / TICK_MS);
+	update_weapon_system(weapon_system, player, &input, maze,
+		&game_state->rng);
+	return (0);
+}
+
+/**
+ * hash_bytes - Folds a block of memory into an FNV-1a hash
+ * @hash: Running hash
+ * @data: Bytes to add
+ * @size: Number of bytes
+ * Return: Updated hash
+ */
+Uint32 hash_bytes(Uint32 hash, const void *data, size_t size)
+{
+	const Uint8 *p = data;
+
+	while (size--)
+		hash = (hash ^ *p++) * 16777619u;
+	return (hash);
+}
+
+/**
+ * game_state_hash - Hashes all simulation state
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: FNV-1a hash, used to check that a replay is bit-identical
+ */
+Uint32 game_state_hash(const GameState *game_state, const Player *player,
+		const WeaponSystem *weapon_system)
+{
+	Uint32 hash = 2166136261u;
+
+	hash = hash_bytes(hash, &game_state->rng, sizeof(game_state->rng));
+	hash = hash_bytes(hash, &game_state->tick, sizeof(game_state->tick));
+	hash = hash_bytes(hash, &player->x, sizeof(player->x));
+	hash = hash_bytes(hash, &player->y, sizeof(player->y));
+	hash = hash_bytes(hash, &player->angle, sizeof(player->angle));
+	hash = hash_bytes(hash, weapon_system->enemies,
+		sizeof(weapon_system->enemies));
+	hash = hash_bytes(hash, weapon_system->bullets,
+		sizeof(weapon_system->bullets));
+	hash = hash_bytes(hash, &weapon_system->enemy_count, sizeof(int));
+	hash = hash_bytes(hash, &weapon_system->score, sizeof(int));
+	hash = hash_bytes(hash, &weapon_system->player_health, sizeof(int));
+	hash = hash_bytes(hash, &weapon_system->last_shot_time, sizeof(Uint32));
+	hash = hash_bytes(hash, weapon_system->ai_tier,
+		sizeof(weapon_system->ai_tier));
+	hash = hash_bytes(hash, &weapon_system->ai_cursor, sizeof(int));
+	hash = hash_bytes(hash, weapon_system->behaviours,
+		sizeof(weapon_system->behaviours));
+	hash = hash_bytes(hash, door_open, sizeof(door_open));
+	return (hash);
+}
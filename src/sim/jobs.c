@@ -0,0 +1,141 @@
+#include "../../inc/jobs.h"
+#include <string.h>
+
+/**
+ * run_chunks - Grabs chunks of the current loop until none are left
+ * @pool: Job pool
+ */
+static void run_chunks(JobPool *pool)
+{
+	int begin, end;
+
+	while (1)
+	{
+		begin = SDL_AtomicAdd(&pool->next, pool->chunk);
+		if (begin >= pool->count)
+			break;
+		end = begin + pool->chunk < pool->count ?
+			begin + pool->chunk : pool->count;
+		pool->func(pool->context, begin, end);
+	}
+}
+
+/**
+ * worker_main - Worker thread: waits for loops and helps run them
+ * @data: Pointer to the JobPool
+ * Return: 0
+ */
+static int worker_main(void *data)
+{
+	JobPool *pool = data;
+	int seen = 0;
+
+	SDL_LockMutex(pool->lock);
+	while (1)
+	{
+		while (pool->generation == seen && !pool->quit)
+			SDL_CondWait(pool->wake, pool->lock);
+		if (pool->quit)
+			break;
+		seen = pool->generation;
+		SDL_UnlockMutex(pool->lock);
+		run_chunks(pool);
+		SDL_LockMutex(pool->lock);
+		if (--pool->busy == 0)
+			SDL_CondSignal(pool->done);
+	}
+	SDL_UnlockMutex(pool->lock);
+	return (0);
+}
+
+/**
+ * job_pool_init - Starts the worker threads
+ * @pool: Pool to initialize
+ * @threads: Threads to use, including the caller; 0 for one per CPU core
+ * Return: 0 on success, -1 on failure (the pool then runs loops inline)
+ */
+int job_pool_init(JobPool *pool, int threads)
+{
+	int i;
+
+	memset(pool, 0, sizeof(*pool));
+	if (threads <= 0)
+		threads = SDL_GetCPUCount();
+	if (threads > JOBS_MAX_THREADS)
+		threads = JOBS_MAX_THREADS;
+	pool->threads = 1;
+	if (threads == 1)
+		return (0);
+	pool->lock = SDL_CreateMutex();
+	pool->wake = SDL_CreateCond();
+	pool->done = SDL_CreateCond();
+	if (!pool->lock || !pool->wake || !pool->done)
+		return (-1);
+	for (i = 0; i < threads - 1; i++)
+	{
+		pool->workers[i] = SDL_CreateThread(worker_main, "jobs", pool);
+		if (!pool->workers[i])
+			return (-1);
+		pool->threads++;
+	}
+	return (0);
+}
+
+/**
+ * job_pool_run - Runs a parallel loop and waits for it to finish
+ * @pool: Job pool, or NULL to run the loop inline
+ * @func: Loop body
+ * @context: Data passed to every call of @func
+ * @count: Number of items
+ * @chunk: Items per grab; small chunks balance uneven work better
+ */
+void job_pool_run(JobPool *pool, JobFunc func, void *context, int count,
+		int chunk)
+{
+	if (!pool || pool->threads <= 1 || count <= chunk)
+	{
+		func(context, 0, count);
+		return;
+	}
+	SDL_LockMutex(pool->lock);
+	pool->func = func;
+	pool->context = context;
+	pool->count = count;
+	pool->chunk = chunk > 0 ? chunk : 1;
+	SDL_AtomicSet(&pool->next, 0);
+	pool->busy = pool->threads - 1;
+	pool->generation++;
+	SDL_CondBroadcast(pool->wake);
+	SDL_UnlockMutex(pool->lock);
+
+	run_chunks(pool);
+
+	SDL_LockMutex(pool->lock);
+	while (pool->busy > 0)
+		SDL_CondWait(pool->done, pool->lock);
+	SDL_UnlockMutex(pool->lock);
+}
+
+/**
+ * job_pool_destroy - Stops the worker threads and frees the pool
+ * @pool: Pool to destroy
+ */
+void job_pool_destroy(JobPool *pool)
+{
+	int i;
+
+	if (pool->lock)
+	{
+		SDL_LockMutex(pool->lock);
+		pool->quit = 1;
+		SDL_CondBroadcast(pool->wake);
+		SDL_UnlockMutex(pool->lock);
+	}
+	for (i = 0; i < JOBS_MAX_THREADS; i++)
+		if (pool->workers[i])
+			SDL_WaitThread(pool->workers[i], NULL);
+	SDL_DestroyCond(pool->done);
+	SDL_DestroyCond(pool->wake);
+	SDL_DestroyMutex(pool->lock);
+	memset(pool, 0, sizeof(*pool));
+}
@@ -0,0 +1,110 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+#include "../../inc/lightmap.h"
+
+/* Static torches, baked into the lightmap when the level loads */
+static const Light torches[] = {
+	{1.5f, 3.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{7.5f, 7.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{13.5f, 3.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{13.5f, 9.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{9.5f, 11.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{5.5f, 13.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1},
+	{11.5f, 13.5f, TORCH_RADIUS, TORCH_STRENGTH, 0, 1}
+};
+
+/**
+ * light_contribution - Light levels a light adds to one cell
+ * @light: Light
+ * @cx: Cell column
+ * @cy: Cell row
+ * Return: Levels added at the cell center, 0 if out of reach or occluded
+ *
+ * Only depends on its arguments and the fixed maze layout (doors and
+ * grates let light through), so removing a light subtracts exactly what
+ * placing it added.
+ */
+static int light_contribution(const Light *light, int cx, int cy)
+{
+	float dx = cx + 0.5f - light->x, dy = cy + 0.5f - light->y;
+	float distance = sqrtf(dx * dx + dy * dy);
+
+	if (distance >= light->radius || maze[cy][cx] != 0 ||
+		!pvs_segment_clear(maze, light->x, light->y, cx + 0.5f, cy + 0.5f))
+		return (0);
+	return ((int)(light->strength * (1.0f - distance / light->radius) +
+		0.5f));
+}
+
+/**
+ * lightmap_apply - Adds or subtracts a dynamic light's contribution
+ * @lightmap: Lightmap
+ * @light: Light to apply
+ * @sign: 1 to add the light, -1 to remove it
+ *
+ * Only the cells inside the light's radius are touched.
+ */
+void lightmap_apply(Lightmap *lightmap, const Light *light, int sign)
+{
+	int x0, x1, y0, y1, cx, cy, sum;
+
+	x0 = light->x - light->radius < 0 ? 0 : (int)(light->x - light->radius);
+	y0 = light->y - light->radius < 0 ? 0 : (int)(light->y - light->radius);
+	x1 = (int)(light->x + light->radius);
+	y1 = (int)(light->y + light->radius);
+	x1 = x1 >= LIGHTMAP_SIZE ? LIGHTMAP_SIZE - 1 : x1;
+	y1 = y1 >= LIGHTMAP_SIZE ? LIGHTMAP_SIZE - 1 : y1;
+	lightmap->version++;
+	for (cy = y0; cy <= y1; cy++)
+		for (cx = x0; cx <= x1; cx++)
+		{
+			lightmap->dynamic[cy][cx] += sign *
+				light_contribution(light, cx, cy);
+			sum = lightmap->baked[cy][cx] + lightmap->dynamic[cy][cx];
+			lightmap->level[cy][cx] = sum > LIGHT_LEVELS ? LIGHT_LEVELS :
+				sum < -LIGHT_LEVELS ? -LIGHT_LEVELS : sum;
+		}
+}
+
+/**
+ * lightmap_bake - Computes the static lighting of the level
+ * @lightmap: Lightmap to initialize
+ * @maze: Maze layout
+ *
+ * Clears every dynamic light and bakes ambient plus torch light.
+ */
+void lightmap_bake(Lightmap *lightmap, const int maze[15][15])
+{
+	int count = sizeof(torches) / sizeof(torches[0]), i, cx, cy, sum;
+
+	for (cy = 0; cy < LIGHTMAP_SIZE; cy++)
+		for (cx = 0; cx < LIGHTMAP_SIZE; cx++)
+		{
+			sum = LIGHT_AMBIENT;
+			for (i = 0; i < count && maze[cy][cx] == 0; i++)
+				sum += light_contribution(&torches[i], cx, cy);
+			lightmap->baked[cy][cx] = sum;
+			lightmap->dynamic[cy][cx] = 0;
+			lightmap->level[cy][cx] = sum > LIGHT_LEVELS ? LIGHT_LEVELS : sum;
+		}
+	for (i = 0; i < MAX_LIGHTS; i++)
+		lightmap->lights[i].active = 0;
+	lightmap->version++;
+}
+
+/**
+ * lightmap_sample - Light level offset at a point
+ * @lightmap: Lightmap, or NULL for unlit rendering
+ * @x: X position in the maze
+ * @y: Y position in the maze
+ * Return: Offset to add to the distance light level
+ */
+int lightmap_sample(const Lightmap *lightmap, float x, float y)
+{
+	int cx = (int)x, cy = (int)y;
+
+	if (!lightmap || x < 0 || y < 0 || cx >= LIGHTMAP_SIZE ||
+		cy >= LIGHTMAP_SIZE)
+		return (0);
+	return (lightmap->level[cy][cx]);
+}
@@ -0,0 +1,66 @@
+#include "../../inc/maze.h"
+#include "../../inc/lightmap.h"
+
+/**
+ * lightmap_place - Turns on a muzzle flash light or moves it
+ * @lightmap: Lightmap, or NULL to ignore lights
+ * @id: Light slot, the index of the bullet that owns it
+ * @x: New X position
+ * @y: New Y position
+ * @expires: Simulation time the light goes out
+ *
+ * Lighting is per cell, so a light that moves within its cell keeps the
+ * position it was applied at; only crossing into another cell costs an
+ * update.
+ */
+void lightmap_place(Lightmap *lightmap, int id, float x, float y,
+			Uint32 expires)
+{
+	Light *light;
+
+	if (!lightmap || id < 0 || id >= MAX_LIGHTS)
+		return;
+	light = &lightmap->lights[id];
+	light->expires = expires;
+	if (light->active && (int)light->x == (int)x && (int)light->y == (int)y)
+		return;
+	if (light->active)
+		lightmap_apply(lightmap, light, -1);
+	light->x = x;
+	light->y = y;
+	light->radius = MUZZLE_RADIUS;
+	light->strength = MUZZLE_STRENGTH;
+	light->active = 1;
+	lightmap_apply(lightmap, light, 1);
+}
+
+/**
+ * lightmap_remove - Turns off a dynamic light
+ * @lightmap: Lightmap, or NULL to ignore lights
+ * @id: Light slot
+ */
+void lightmap_remove(Lightmap *lightmap, int id)
+{
+	if (!lightmap || id < 0 || id >= MAX_LIGHTS ||
+		!lightmap->lights[id].active)
+		return;
+	lightmap_apply(lightmap, &lightmap->lights[id], -1);
+	lightmap->lights[id].active = 0;
+}
+
+/**
+ * lightmap_expire - Turns off every light whose time is up
+ * @lightmap: Lightmap, or NULL to ignore lights
+ * @time: Current simulation time
+ */
+void lightmap_expire(Lightmap *lightmap, Uint32 time)
+{
+	int i;
+
+	if (!lightmap)
+		return;
+	for (i = 0; i < MAX_LIGHTS; i++)
+		if (lightmap->lights[i].active &&
+			(Sint32)(time - lightmap->lights[i].expires) >= 0)
+			lightmap_remove(lightmap, i);
+}
@@ -0,0 +1,126 @@
+#include "../../inc/maze.h"
+#include "../../inc/pvs.h"
+#include <string.h>
+
+/**
+ * pvs_segment_clear - Checks a segment against solid walls
+ * @maze: Maze layout
+ * @x0: Start X
+ * @y0: Start Y
+ * @x1: End X
+ * @y1: End Y
+ * Return: 1 if no solid wall cell is crossed, 0 otherwise
+ *
+ * Walks every cell the segment passes through with a grid DDA, so unlike
+ * fixed-step marching it never steps over a wall corner.
+ */
+int pvs_segment_clear(const int maze[15][15], float x0, float y0,
+			float x1, float y1)
+{
+	int cx = (int)x0, cy = (int)y0, steps;
+	float dx = x1 - x0, dy = y1 - y0;
+	float step_x = dx != 0 ? fabsf(1.0f / dx) : 1e30f;
+	float step_y = dy != 0 ? fabsf(1.0f / dy) : 1e30f;
+	float next_x = 1e30f, next_y = 1e30f;
+
+	/* Segment fraction at which the next column and row boundaries lie */
+	if (dx != 0)
+		next_x = (dx > 0 ? cx + 1 - x0 : x0 - cx) * step_x;
+	if (dy != 0)
+		next_y = (dy > 0 ? cy + 1 - y0 : y0 - cy) * step_y;
+	for (steps = 0; steps < 2 * PVS_SIZE; steps++)
+	{
+		if (next_x > 1.0f && next_y > 1.0f)
+			return (1);
+		if (next_x < next_y)
+		{
+			next_x += step_x;
+			cx += dx > 0 ? 1 : -1;
+		}
+		else
+		{
+			next_y += step_y;
+			cy += dy > 0 ? 1 : -1;
+		}
+		if (cx < 0 || cy < 0 || cx >= PVS_SIZE || cy >= PVS_SIZE ||
+			maze[cy][cx] == 1)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * cells_see - Checks whether any sample point of one cell sees another
+ * @maze: Maze layout
+ * @a: First cell index
+ * @b: Second cell index
+ * Return: 1 if some pair of sample points has a clear segment
+ */
+static int cells_see(const int maze[15][15], int a, int b)
+{
+	static const float offset[PVS_SAMPLES] = {0.05f, 0.5f, 0.95f};
+	int i, j;
+	float ax, ay;
+
+	for (i = 0; i < PVS_SAMPLES * PVS_SAMPLES; i++)
+	{
+		ax = a % PVS_SIZE + offset[i % PVS_SAMPLES];
+		ay = a / PVS_SIZE + offset[i / PVS_SAMPLES];
+		for (j = 0; j < PVS_SAMPLES * PVS_SAMPLES; j++)
+			if (pvs_segment_clear(maze, ax, ay,
+				b % PVS_SIZE + offset[j % PVS_SAMPLES],
+				b / PVS_SIZE + offset[j / PVS_SAMPLES]))
+				return (1);
+	}
+	return (0);
+}
+
+/**
+ * pvs_build - Computes the potentially visible set of every cell
+ * @pvs: Sets to fill
+ * @maze: Maze layout
+ *
+ * Run once when the level loads. Visibility is symmetric, so each pair
+ * of open cells is tested once.
+ */
+void pvs_build(Pvs *pvs, const int maze[15][15])
+{
+	int a, b;
+
+	memset(pvs, 0, sizeof(*pvs));
+	for (a = 0; a < PVS_CELLS; a++)
+	{
+		if (maze[a / PVS_SIZE][a % PVS_SIZE] == 1)
+			continue;
+		pvs->bits[a][a >> 5] |= 1u << (a & 31);
+		for (b = a + 1; b < PVS_CELLS; b++)
+			if (maze[b / PVS_SIZE][b % PVS_SIZE] != 1 && cells_see(maze, a, b))
+			{
+				pvs->bits[a][b >> 5] |= 1u << (b & 31);
+				pvs->bits[b][a >> 5] |= 1u << (a & 31);
+			}
+	}
+}
+
+/**
+ * pvs_visible - Tests whether one point could possibly see another
+ * @pvs: Potentially visible sets, or NULL to treat everything as visible
+ * @from_x: Viewer X position
+ * @from_y: Viewer Y position
+ * @to_x: Target X position
+ * @to_y: Target Y position
+ * Return: 0 if the target is certainly hidden, 1 if it may be visible
+ */
+int pvs_visible(const Pvs *pvs, float from_x, float from_y,
+		float to_x, float to_y)
+{
+	int a, b;
+
+	if (!pvs || from_x < 0 || from_y < 0 || to_x < 0 || to_y < 0 ||
+		from_x >= PVS_SIZE || from_y >= PVS_SIZE || to_x >= PVS_SIZE ||
+		to_y >= PVS_SIZE)
+		return (1);
+	a = (int)from_y * PVS_SIZE + (int)from_x;
+	b = (int)to_y * PVS_SIZE + (int)to_x;
+	return ((pvs->bits[a][b >> 5] >> (b & 31)) & 1);
+}
@@ -0,0 +1,99 @@
+#include "../../inc/replay.h"
+#include <string.h>
+
+/**
+ * replay_write_u32 - Writes a little-endian 32-bit value
+ * @file: Output file
+ * @value: Value to write
+ */
+void replay_write_u32(FILE *file, Uint32 value)
+{
+	fputc(value & 0xFF, file);
+	fputc((value >> 8) & 0xFF, file);
+	fputc((value >> 16) & 0xFF, file);
+	fputc((value >> 24) & 0xFF, file);
+}
+
+/**
+ * replay_read_u32 - Reads a little-endian 32-bit value
+ * @file: Input file
+ * @value: Receives the value
+ * Return: 0 on success, -1 on end of file
+ */
+int replay_read_u32(FILE *file, Uint32 *value)
+{
+	int i, c;
+
+	*value = 0;
+	for (i = 0; i < 4; i++)
+	{
+		c = fgetc(file);
+		if (c == EOF)
+			return (-1);
+		*value |= (Uint32)c << (i * 8);
+	}
+	return (0);
+}
+
+/**
+ * replay_record_start - Opens a replay file for recording
+ * @replay: Replay to initialize
+ * @path: Output path, or NULL to play live without recording
+ * @seed: Seed the game RNG is started from
+ * @tick_ms: Simulation tick length
+ * Return: 0 on success, -1 on failure
+ */
+int replay_record_start(Replay *replay, const char *path, Uint32 seed,
+		Uint32 tick_ms)
+{
+	memset(replay, 0, sizeof(*replay));
+	replay->seed = seed;
+	replay->tick_ms = tick_ms;
+	if (!path)
+		return (0);
+	replay->file = fopen(path, "wb");
+	if (!replay->file)
+	{
+		printf("Cannot open replay %s for writing\n", path);
+		return (-1);
+	}
+	replay->mode = REPLAY_RECORD;
+	fwrite(REPLAY_MAGIC, 1, 4, replay->file);
+	fputc(REPLAY_VERSION, replay->file);
+	replay_write_u32(replay->file, seed);
+	replay_write_u32(replay->file, tick_ms);
+	return (0);
+}
+
+/**
+ * replay_play_start - Opens a replay file for playback
+ * @replay: Replay to initialize; seed and tick length come from the file
+ * @path: Replay path
+ * Return: 0 on success, -1 on failure
+ */
+int replay_play_start(Replay *replay, const char *path)
+{
+	char magic[4];
+
+	memset(replay, 0, sizeof(*replay));
+	replay->file = fopen(path, "rb");
+	if (!replay->file)
+	{
+		printf("Cannot open replay %s\n", path);
+		return (-1);
+	}
+	if (fread(magic, 1, 4, replay->file) != 4 ||
+		memcmp(magic, REPLAY_MAGIC, 4) != 0 ||
+		fgetc(replay->file) != REPLAY_VERSION ||
+		replay_read_u32(replay->file, &replay->seed) != 0 ||
+		replay_read_u32(replay->file, &replay->tick_ms) != 0 ||
+		replay->tick_ms == 0)
+	{
+		printf("%s is not a version %d replay\n", path, REPLAY_VERSION);
+		fclose(replay->file);
+		replay->file = NULL;
+		return (-1);
+	}
+	replay->mode = REPLAY_PLAY;
+	return (0);
+}
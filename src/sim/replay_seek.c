@@ -0,0 +1,34 @@
+#include "../../inc/replay.h"
+
+/**
+ * replay_mark - Notes the current position of a replay
+ * @replay: Replay being recorded, played or off
+ * @mark: Receives the position
+ */
+void replay_mark(const Replay *replay, ReplayMark *mark)
+{
+	mark->offset = replay->file ? ftell(replay->file) : 0;
+	mark->buttons = replay->buttons;
+	mark->run = replay->run;
+	mark->ticks = replay->ticks;
+}
+
+/**
+ * replay_seek - Moves a replay back to a marked position
+ * @replay: Replay the mark was taken from
+ * @mark: Position from replay_mark()
+ * Return: 0 on success, -1 if the file could not be repositioned
+ *
+ * Used together with a saved state to rewind: the state restores the
+ * simulation, the mark the input that follows it.
+ */
+int replay_seek(Replay *replay, const ReplayMark *mark)
+{
+	if (replay->file && fseek(replay->file, mark->offset, SEEK_SET) != 0)
+		return (-1);
+	replay->buttons = mark->buttons;
+	replay->run = mark->run;
+	replay->ticks = mark->ticks;
+	replay->ended = 0;
+	return (0);
+}
@@ -0,0 +1,99 @@
+#include "../../inc/replay.h"
+
+/**
+ * flush_run - Writes the pending (buttons, run) pair
+ * @replay: Recording replay
+ */
+static void flush_run(Replay *replay)
+{
+	if (replay->run == 0)
+		return;
+	fputc(replay->buttons, replay->file);
+	fputc(replay->run, replay->file);
+	replay->run = 0;
+}
+
+/**
+ * replay_record - Appends one tick of input to a recording
+ * @replay: Replay; does nothing unless recording
+ * @input: Input applied this tick
+ */
+void replay_record(Replay *replay, const Input *input)
+{
+	if (replay->mode != REPLAY_RECORD)
+		return;
+	if (replay->run > 0 && (input->buttons != replay->buttons ||
+		replay->run == 255))
+		flush_run(replay);
+	replay->buttons = input->buttons;
+	replay->run++;
+	replay->ticks++;
+}
+
+/**
+ * replay_play - Reads the input of the next tick
+ * @replay: Playing replay
+ * @input: Receives the recorded input
+ * Return: 0 on success, -1 once the recording is exhausted
+ */
+int replay_play(Replay *replay, Input *input)
+{
+	int buttons, run;
+
+	if (replay->ended)
+		return (-1);
+	while (replay->run == 0)
+	{
+		buttons = fgetc(replay->file);
+		run = fgetc(replay->file);
+		if (buttons == EOF || run == EOF || buttons == REPLAY_END)
+		{
+			replay->ended = buttons == REPLAY_END &&
+				replay_read_u32(replay->file, &replay->end_ticks) == 0 &&
+				replay_read_u32(replay->file, &replay->end_hash) == 0;
+			replay->ended = replay->ended ? 1 : -1;
+			return (-1);
+		}
+		replay->buttons = (Uint8)buttons;
+		replay->run = (Uint8)run;
+	}
+	input->buttons = replay->buttons;
+	replay->run--;
+	replay->ticks++;
+	return (0);
+}
+
+/**
+ * replay_finish - Closes a replay, writing or checking the trailer
+ * @replay: Replay to close
+ * @state_hash: Hash of the simulation state after the last tick
+ * Return: 0 on success, -1 if playback diverged from the recording
+ */
+int replay_finish(Replay *replay, Uint32 state_hash)
+{
+	int status = 0;
+
+	if (replay->mode == REPLAY_RECORD)
+	{
+		flush_run(replay);
+		fputc(REPLAY_END, replay->file);
+		fputc(0, replay->file);
+		replay_write_u32(replay->file, replay->ticks);
+		replay_write_u32(replay->file, state_hash);
+		printf("Replay: recorded %u ticks, state hash %08x\n",
+			(unsigned int)replay->ticks, (unsigned int)state_hash);
+	}
+	else if (replay->mode == REPLAY_PLAY && replay->ended == 1)
+	{
+		status = (replay->ticks == replay->end_ticks &&
+			state_hash == replay->end_hash) ? 0 : -1;
+		printf("Replay: %u ticks, state hash %08x (recorded %08x): %s\n",
+			(unsigned int)replay->ticks, (unsigned int)state_hash,
+			(unsigned int)replay->end_hash, status ? "DIVERGED" : "identical");
+	}
+	if (replay->file)
+		fclose(replay->file);
+	replay->file = NULL;
+	replay->mode = REPLAY_OFF;
+	return (status);
+}
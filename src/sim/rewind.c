@@ -0,0 +1,83 @@
+#include "../../inc/save.h"
+
+/**
+ * rewind_init - Empties a checkpoint ring
+ * @ring: Checkpoint ring
+ * @tick_ms: Simulation tick length; one checkpoint is taken per second
+ */
+void rewind_init(Rewind *ring, Uint32 tick_ms)
+{
+	int i;
+
+	for (i = 0; i < REWIND_SLOTS; i++)
+		ring->slots[i].size = 0;
+	ring->interval = tick_ms > 0 && tick_ms < 1000 ? 1000 / tick_ms : 1;
+}
+
+/**
+ * rewind_capture - Takes a checkpoint if one is due this tick
+ * @ring: Checkpoint ring
+ * @replay: Replay whose position is kept with the checkpoint
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ *
+ * Call after every tick, and once after the game starts or is loaded.
+ */
+void rewind_capture(Rewind *ring, const Replay *replay,
+		const GameState *game_state, const Player *player,
+		const WeaponSystem *weapon_system)
+{
+	Checkpoint *slot;
+
+	if (game_state->tick % ring->interval != 0)
+		return;
+	slot = &ring->slots[game_state->tick / ring->interval % REWIND_SLOTS];
+	slot->size = save_state(slot->data, sizeof(slot->data), game_state,
+		player, weapon_system);
+	slot->tick = game_state->tick;
+	replay_mark(replay, &slot->mark);
+}
+
+/**
+ * rewind_back - Goes back about REWIND_SECONDS
+ * @ring: Checkpoint ring
+ * @replay: Replay moved back along with the state
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: 0 on success, -1 if there was no checkpoint to go back to
+ *
+ * Restores the newest checkpoint at least REWIND_SECONDS old, or the
+ * oldest one if none is. Checkpoints after it are dropped, since the
+ * game may now take another course. A played-back replay continues from
+ * there and still ends on the recorded state; a recording continues from
+ * there and drops what was recorded after it.
+ */
+int rewind_back(Rewind *ring, Replay *replay, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system)
+{
+	Uint32 back = REWIND_SECONDS * ring->interval;
+	Uint32 target = game_state->tick > back ? game_state->tick - back : 0;
+	Checkpoint *best = NULL, *oldest = NULL, *slot;
+	int i;
+
+	for (i = 0; i < REWIND_SLOTS; i++)
+	{
+		slot = &ring->slots[i];
+		if (slot->size == 0)
+			continue;
+		if (!oldest || slot->tick < oldest->tick)
+			oldest = slot;
+		if (slot->tick <= target && (!best || slot->tick > best->tick))
+			best = slot;
+	}
+	best = best ? best : oldest;
+	if (!best || load_state(best->data, best->size, game_state, player,
+		weapon_system) != 0 || replay_seek(replay, &best->mark) != 0)
+		return (-1);
+	for (i = 0; i < REWIND_SLOTS; i++)
+		if (ring->slots[i].tick > best->tick)
+			ring->slots[i].size = 0;
+	return (0);
+}
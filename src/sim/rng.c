@@ -0,0 +1,37 @@
+#include "../../inc/rng.h"
+
+/**
+ * rng_seed - Seeds the generator
+ * @rng: Generator
+ * @seed: Any value; zero is remapped since xorshift cannot leave it
+ */
+void rng_seed(Rng *rng, Uint32 seed)
+{
+	rng->state = seed ? seed : 0x9E3779B9u;
+}
+
+/**
+ * rng_next - Returns the next 32-bit value
+ * @rng: Generator
+ * Return: Pseudo-random value
+ */
+Uint32 rng_next(Rng *rng)
+{
+	Uint32 x = rng->state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	rng->state = x;
+	return (x);
+}
+
+/**
+ * rng_float - Returns a value in [0, 1)
+ * @rng: Generator
+ * Return: Pseudo-random float
+ */
+float rng_float(Rng *rng)
+{
+	return ((rng_next(rng) >> 8) * (1.0f / 16777216.0f));
+}
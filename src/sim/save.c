@@ -0,0 +1,236 @@
+#include "../../inc/save.h"
+#include <string.h>
+
+/* Host index of the i-th least significant byte of a size-byte value */
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define SAVE_BYTE(i, size) ((size) - 1 - (i))
+#else
+#define SAVE_BYTE(i, size) (i)
+#endif
+
+#define SAVE_FIELD(stream, field) save_field((stream), &(field), sizeof(field))
+
+/**
+ * save_field - Writes a value when writing, reads it back when reading
+ * @stream: Save stream
+ * @value: Integer or float field
+ * @size: Size of the field in bytes
+ */
+static void save_field(SaveStream *stream, void *value, size_t size)
+{
+	Uint8 *bytes = value;
+	size_t i;
+
+	if (stream->pos + size > stream->size)
+	{
+		stream->overflow = 1;
+		return;
+	}
+	for (i = 0; i < size; i++)
+		if (stream->writing)
+			stream->data[stream->pos + i] = bytes[SAVE_BYTE(i, size)];
+		else
+			bytes[SAVE_BYTE(i, size)] = stream->data[stream->pos + i];
+	stream->pos += size;
+}
+
+/**
+ * code_state - Writes or reads every simulation field of a save
+ * @stream: Save stream
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * @doors: Open amount of every cell; only door cells are coded
+ * Return: 0 on success, -1 if the header does not match this build
+ *
+ * The header holds the magic, version, array sizes and door count, so a
+ * save from another version or maze is refused before any field is read.
+ * Only the doors of the maze are stored, not every cell.
+ */
+static int code_state(SaveStream *stream, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system,
+		Uint8 doors[MAZE_ROWS][MAZE_COLS])
+{
+	Uint8 header[8], got[8];
+	Enemy *e;
+	Behaviour *co;
+	Bullet *b;
+	int i, x, y;
+
+	memcpy(header, SAVE_MAGIC, 4);
+	header[4] = SAVE_VERSION;
+	header[5] = MAX_ENEMIES;
+	header[6] = MAX_BULLETS;
+	header[7] = 0;
+	for (y = 0; y < MAZE_ROWS; y++)
+		for (x = 0; x < MAZE_COLS; x++)
+			header[7] += maze[y][x] == CELL_DOOR;
+	memcpy(got, header, sizeof(got));
+	for (i = 0; i < (int)sizeof(got); i++)
+		SAVE_FIELD(stream, got[i]);
+	if (stream->overflow || memcmp(got, header, sizeof(got)) != 0)
+		return (-1);
+	SAVE_FIELD(stream, weapon_system->tick_ms);
+	SAVE_FIELD(stream, game_state->tick);
+	SAVE_FIELD(stream, game_state->rng.state);
+	SAVE_FIELD(stream, game_state->input.buttons);
+	SAVE_FIELD(stream, player->x);
+	SAVE_FIELD(stream, player->y);
+	SAVE_FIELD(stream, player->angle);
+	SAVE_FIELD(stream, player->dx);
+	SAVE_FIELD(stream, player->dy);
+	for (i = 0, e = weapon_system->enemies; i < MAX_ENEMIES; i++, e++)
+	{
+		SAVE_FIELD(stream, e->x);
+		SAVE_FIELD(stream, e->y);
+		SAVE_FIELD(stream, e->alive);
+		SAVE_FIELD(stream, e->health);
+		SAVE_FIELD(stream, e->speed);
+		SAVE_FIELD(stream, e->last_attack);
+		SAVE_FIELD(stream, e->frame_time);
+		SAVE_FIELD(stream, e->frame);
+		SAVE_FIELD(stream, e->direction);
+		SAVE_FIELD(stream, e->thought);
+		SAVE_FIELD(stream, weapon_system->ai_tier[i]);
+		SAVE_FIELD(stream, e->mode);
+		SAVE_FIELD(stream, e->goal_x);
+		SAVE_FIELD(stream, e->goal_y);
+		co = &weapon_system->behaviours[i];
+		SAVE_FIELD(stream, co->wake);
+		SAVE_FIELD(stream, co->x);
+		SAVE_FIELD(stream, co->y);
+		SAVE_FIELD(stream, co->line);
+		SAVE_FIELD(stream, co->script);
+		SAVE_FIELD(stream, co->wait);
+	}
+	for (i = 0, b = weapon_system->bullets; i < MAX_BULLETS; i++, b++)
+	{
+		SAVE_FIELD(stream, b->x);
+		SAVE_FIELD(stream, b->y);
+		SAVE_FIELD(stream, b->dx);
+		SAVE_FIELD(stream, b->dy);
+		SAVE_FIELD(stream, b->active);
+		SAVE_FIELD(stream, b->created);
+	}
+	SAVE_FIELD(stream, weapon_system->enemy_count);
+	SAVE_FIELD(stream, weapon_system->score);
+	SAVE_FIELD(stream, weapon_system->player_health);
+	SAVE_FIELD(stream, weapon_system->last_shot_time);
+	SAVE_FIELD(stream, weapon_system->time);
+	SAVE_FIELD(stream, weapon_system->ai_cursor);
+	for (y = 0; y < MAZE_ROWS; y++)
+		for (x = 0; x < MAZE_COLS; x++)
+			if (maze[y][x] == CELL_DOOR)
+				SAVE_FIELD(stream, doors[y][x]);
+	return (stream->overflow ? -1 : 0);
+}
+
+/**
+ * relight - Puts the muzzle flashes back in line with the bullets
+ * @weapon_system: Weapon system whose state was just loaded
+ *
+ * The lightmap is not saved; every flash is taken out and the ones of
+ * bullets still young enough are placed again, which lights the same
+ * cells as an uninterrupted run.
+ */
+static void relight(WeaponSystem *weapon_system)
+{
+	Bullet *b;
+	int i;
+
+	if (!weapon_system->lightmap)
+		return;
+	for (i = 0; i < MAX_LIGHTS; i++)
+		lightmap_remove(weapon_system->lightmap, i);
+	for (i = 0; i < MAX_BULLETS; i++)
+	{
+		b = &weapon_system->bullets[i];
+		if (b->active && weapon_system->time - b->created < MUZZLE_FLASH_MS)
+			lightmap_place(weapon_system->lightmap, i, b->x, b->y,
+				b->created + MUZZLE_FLASH_MS);
+	}
+}
+
+/**
+ * save_state - Writes the simulation state into a buffer
+ * @data: Output buffer, SAVE_MAX bytes is always enough
+ * @size: Size of @data
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: Bytes written, 0 if @data is too small
+ *
+ * Everything step_game() reads is stored, field by field with no padding
+ * or pointers, followed by an FNV-1a checksum of the bytes before it.
+ * Takes a few microseconds, so it can run every tick if need be.
+ */
+size_t save_state(Uint8 *data, size_t size, const GameState *game_state,
+		const Player *player, const WeaponSystem *weapon_system)
+{
+	SaveStream stream = {0};
+	Uint32 checksum;
+
+	stream.data = data;
+	stream.size = size;
+	stream.writing = 1;
+	/* Fields are only read while writing */
+	if (code_state(&stream, (GameState *)game_state, (Player *)player,
+		(WeaponSystem *)weapon_system, door_open) != 0)
+		return (0);
+	checksum = hash_bytes(2166136261u, data, stream.pos);
+	SAVE_FIELD(&stream, checksum);
+	return (stream.overflow ? 0 : stream.pos);
+}
+
+/**
+ * load_state - Restores the simulation state from a save
+ * @data: Save bytes
+ * @size: Size of the save
+ * @game_state: Receives the tick, RNG and last input
+ * @player: Receives the player
+ * @weapon_system: Receives enemies, bullets, score and timers; its
+ * lightmap, PVS and thread pool are kept
+ * Return: 0 on success, -1 if the save is damaged or from another
+ * version
+ *
+ * The fields are read into copies of the state, which replace it only
+ * once the checksum, header and length all matched; a bad save leaves
+ * the game as it was, so a failed rewind or autosave restore can carry
+ * on from there. Doors are restored too, and the scheduler's wheel is rebuilt from the
+ * behaviours' timers. Stepping on from a loaded state gives exactly
+ * the ticks that followed the save.
+ */
+int load_state(const Uint8 *data, size_t size, GameState *game_state,
+		Player *player, WeaponSystem *weapon_system)
+{
+	WeaponSystem weapons;
+	SaveStream stream = {0};
+	GameState game = *game_state;
+	Player body = *player;
+	Uint8 doors[MAZE_ROWS][MAZE_COLS];
+	Uint32 checksum;
+
+	if (size < sizeof(checksum) || size > SAVE_MAX)
+		return (-1);
+	stream.data = (Uint8 *)data; /* Only read from while reading */
+	stream.size = size;
+	stream.pos = size - sizeof(checksum);
+	SAVE_FIELD(&stream, checksum);
+	if (checksum != hash_bytes(2166136261u, data, size - sizeof(checksum)))
+		return (-1);
+	stream.pos = 0;
+	stream.size = size - sizeof(checksum);
+	/* Fields a save does not hold, such as the lightmap, stay as they are */
+	memcpy(&weapons, weapon_system, sizeof(weapons));
+	memcpy(doors, door_open, sizeof(doors));
+	if (code_state(&stream, &game, &body, &weapons, doors) != 0 ||
+		stream.pos != stream.size)
+		return (-1);
+	*game_state = game;
+	*player = body;
+	memcpy(weapon_system, &weapons, sizeof(weapons));
+	memcpy(door_open, doors, sizeof(door_open));
+	relight(weapon_system);
+	resume_behaviours(weapon_system);
+	return (0);
+}
@@ -0,0 +1,64 @@
+#include "../../inc/save.h"
+
+/**
+ * save_file - Saves the simulation state to a file
+ * @path: Output path; an existing file is replaced
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: 0 on success, -1 on failure
+ */
+int save_file(const char *path, const GameState *game_state,
+		const Player *player, const WeaponSystem *weapon_system)
+{
+	Uint8 data[SAVE_MAX];
+	size_t size = save_state(data, sizeof(data), game_state, player,
+		weapon_system);
+	FILE *file = fopen(path, "wb");
+	int status;
+
+	if (!file)
+	{
+		printf("Cannot open save %s for writing\n", path);
+		return (-1);
+	}
+	status = size > 0 && fwrite(data, 1, size, file) == size ? 0 : -1;
+	if (fclose(file) != 0 || status != 0)
+	{
+		printf("Cannot write save %s\n", path);
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * load_file - Restores the simulation state from a file
+ * @path: Save written by save_file()
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure; its tick_ms is
+ * the tick length the save was made at
+ * Return: 0 on success, -1 on failure
+ */
+int load_file(const char *path, GameState *game_state, Player *player,
+		WeaponSystem *weapon_system)
+{
+	Uint8 data[SAVE_MAX];
+	FILE *file = fopen(path, "rb");
+	size_t size;
+
+	if (!file)
+	{
+		printf("Cannot open save %s\n", path);
+		return (-1);
+	}
+	size = fread(data, 1, sizeof(data), file);
+	fclose(file);
+	if (load_state(data, size, game_state, player, weapon_system) != 0)
+	{
+		printf("%s is not a version %d save of this maze\n", path,
+			SAVE_VERSION);
+		return (-1);
+	}
+	return (0);
+}
@@ -0,0 +1,135 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+/**
+ * wheel_insert - Puts a behaviour in the wheel slot of its wake tick
+ * @scheduler: Scheduler
+ * @i: Behaviour, with its wake tick set
+ */
+static void wheel_insert(Scheduler *scheduler, int i)
+{
+	int *head = &scheduler->wheel[scheduler->behaviours[i].wake % SCHED_WHEEL];
+
+	scheduler->prev[i] = -1;
+	scheduler->next[i] = *head;
+	if (*head >= 0)
+		scheduler->prev[*head] = i;
+	*head = i;
+}
+
+/**
+ * wheel_remove - Takes a behaviour out of its wheel slot
+ * @scheduler: Scheduler
+ * @i: Behaviour, with the wake tick it was inserted with
+ */
+static void wheel_remove(Scheduler *scheduler, int i)
+{
+	int *head = &scheduler->wheel[scheduler->behaviours[i].wake % SCHED_WHEEL];
+
+	if (scheduler->prev[i] >= 0)
+		scheduler->next[scheduler->prev[i]] = scheduler->next[i];
+	else
+		*head = scheduler->next[i];
+	if (scheduler->next[i] >= 0)
+		scheduler->prev[scheduler->next[i]] = scheduler->prev[i];
+}
+
+/**
+ * scheduler_reset - Rebuilds the wheel from the behaviours' wake ticks
+ * @scheduler: Scheduler
+ *
+ * The lists are not part of the saved state: after a load, or once the
+ * behaviours are set up, this puts every timer back in its slot. The
+ * order within a slot may differ from an uninterrupted run, which does
+ * not matter since a script only touches its own enemy.
+ */
+void scheduler_reset(Scheduler *scheduler)
+{
+	int i;
+
+	for (i = 0; i < SCHED_WHEEL; i++)
+		scheduler->wheel[i] = -1;
+	*scheduler->ready_count = 0;
+	for (i = 0; i < scheduler->count; i++)
+		if (scheduler->behaviours[i].wake > 0)
+			wheel_insert(scheduler, i);
+}
+
+/**
+ * scheduler_signal - Wakes a behaviour if it waits for any of some events
+ * @scheduler: Scheduler
+ * @i: Behaviour
+ * @events: BEHAVIOUR_* events that happened to its enemy
+ *
+ * A woken behaviour drops its timer and runs once at the end of the
+ * tick, however many events it gets by then. Costs the same whatever the
+ * number of behaviours.
+ */
+void scheduler_signal(Scheduler *scheduler, int i, Uint8 events)
+{
+	Behaviour *co = &scheduler->behaviours[i];
+
+	if (co->wait & BEHAVIOUR_READY)
+	{
+		co->wait |= events;
+		return;
+	}
+	if (!(co->wait & events))
+		return;
+	if (co->wake > 0)
+	{
+		wheel_remove(scheduler, i);
+		co->wake = 0;
+	}
+	co->wait = BEHAVIOUR_READY | (co->wait & events);
+	scheduler->ready[(*scheduler->ready_count)++] = i;
+}
+
+/**
+ * scheduler_run - Resumes the behaviours due this tick
+ * @scheduler: Scheduler
+ * @enemies: Enemies the behaviours drive, one per behaviour
+ * @tick: Tick that just ran
+ * @tick_ms: Length of a tick, for turning waits into ticks
+ * Return: Number of scripts resumed
+ *
+ * Timers of this tick are taken from their wheel slot first, leaving
+ * later rounds' in place. Each woken script then runs to its next wait,
+ * in the order it was woken. Scripts of dead enemies are dropped.
+ */
+int scheduler_run(Scheduler *scheduler, Enemy *enemies, Uint32 tick,
+		Uint32 tick_ms)
+{
+	Behaviour *co;
+	int i, k, next, resumed = 0;
+
+	for (i = scheduler->wheel[tick % SCHED_WHEEL]; i >= 0; i = next)
+	{
+		next = scheduler->next[i];
+		co = &scheduler->behaviours[i];
+		if (co->wake > tick)
+			continue;
+		wheel_remove(scheduler, i);
+		co->wake = 0;
+		co->wait = BEHAVIOUR_READY | BEHAVIOUR_TIMER;
+		scheduler->ready[(*scheduler->ready_count)++] = i;
+	}
+	for (k = 0; k < *scheduler->ready_count; k++)
+	{
+		i = scheduler->ready[k];
+		co = &scheduler->behaviours[i];
+		if (!enemies[i].alive || co->script >= BEHAVIOUR_SCRIPTS)
+		{
+			co->wait = 0;
+			continue;
+		}
+		behaviour_scripts[co->script](co, &enemies[i]);
+		resumed++;
+		if (co->wake == 0)
+			continue;
+		co->wake = tick + (co->wake + tick_ms - 1) / tick_ms;
+		wheel_insert(scheduler, i);
+	}
+	*scheduler->ready_count = 0;
+	return (resumed);
+}
@@ -0,0 +1,160 @@
+#include "../../inc/net.h"
+#include <string.h>
+
+/**
+ * server_start - Opens the server socket
+ * @server: Server to initialize
+ * @port: UDP port to listen on; 0 picks a free one
+ * @tick_ms: Simulation tick length
+ * Return: 0 on success, -1 on failure
+ */
+int server_start(Server *server, int port, Uint32 tick_ms)
+{
+	memset(server, 0, sizeof(*server));
+	server->port = port;
+	server->tick_ms = tick_ms;
+	server->socket = udp_open(&server->port);
+	return (server->socket < 0 ? -1 : 0);
+}
+
+/**
+ * server_peer - Finds the slot of a client, giving new clients a free one
+ * @server: Server
+ * @from: Address a packet came from
+ * Return: The client's slot, or NULL if the server is full
+ */
+static NetPeer *server_peer(Server *server, const struct sockaddr_in *from)
+{
+	NetPeer *peer, *free_slot = NULL;
+	int i;
+
+	for (i = 0; i < NET_MAX_CLIENTS; i++)
+	{
+		peer = &server->peers[i];
+		if (peer->active && peer->address.sin_port == from->sin_port &&
+			peer->address.sin_addr.s_addr == from->sin_addr.s_addr)
+			return (peer);
+		if (!peer->active && !free_slot)
+			free_slot = peer;
+	}
+	if (!free_slot)
+		return (NULL);
+	memset(free_slot, 0, sizeof(*free_slot));
+	free_slot->address = *from;
+	free_slot->active = 1;
+	return (free_slot);
+}
+
+/**
+ * server_receive - Reads client packets and picks the input of a tick
+ * @server: Server
+ * @tick: Tick about to be simulated
+ * @input: Receives the controlling client's buttons for the tick
+ *
+ * Every packet carries a client's held buttons and the newest snapshot it
+ * has. The lowest active slot controls the player; buttons it pressed and
+ * released between two ticks still reach the next one. Clients silent for
+ * NET_TIMEOUT_MS are dropped; the held buttons are only cleared when the
+ * controller is, as control then passes to the next slot.
+ */
+void server_receive(Server *server, Uint32 tick, Input *input)
+{
+	Uint8 data[NET_PACKET_MAX], buttons;
+	struct sockaddr_in from;
+	NetPeer *peer, *controller;
+	Bits bits;
+	Uint32 ack;
+	int size, i;
+
+	while ((size = udp_receive(server->socket, &from, data,
+		sizeof(data))) >= 0)
+	{
+		bits_init(&bits, data, size, 0);
+		if (bits_read(&bits, 8) != NET_PACKET_CLIENT)
+			continue;
+		buttons = bits_read(&bits, 8);
+		ack = bits_read(&bits, 32);
+		peer = bits.overflow ? NULL : server_peer(server, &from);
+		if (!peer)
+			continue;
+		peer->heard = tick;
+		if (ack > peer->acked && ack < tick)
+			peer->acked = ack;
+		for (controller = server->peers; !controller->active; controller++)
+			;
+		if (peer == controller)
+		{
+			server->held = buttons;
+			server->input |= buttons;
+		}
+	}
+	controller = NULL;
+	for (i = 0; i < NET_MAX_CLIENTS && !controller; i++)
+		if (server->peers[i].active)
+			controller = &server->peers[i];
+	for (i = 0; i < NET_MAX_CLIENTS; i++)
+	{
+		peer = &server->peers[i];
+		if (peer->active && (tick - peer->heard) * server->tick_ms >
+			NET_TIMEOUT_MS)
+		{
+			peer->active = 0;
+			if (peer == controller)
+				server->held = server->input = 0;
+		}
+	}
+	input->buttons = server->input;
+	server->input = server->held;
+}
+
+/**
+ * server_send - Sends a tick's snapshot to every client
+ * @server: Server
+ * @snapshot: State after the tick
+ */
+void server_send(Server *server, const Snapshot *snapshot)
+{
+	static const Snapshot empty;
+	Uint8 data[NET_PACKET_MAX];
+	const Snapshot *base;
+	NetPeer *peer;
+	Bits bits;
+	int i;
+
+	memcpy(&server->history[snapshot->tick & (NET_HISTORY - 1)], snapshot,
+		sizeof(*snapshot));
+	for (i = 0; i < NET_MAX_CLIENTS; i++)
+	{
+		peer = &server->peers[i];
+		if (!peer->active)
+			continue;
+		base = &server->history[peer->acked & (NET_HISTORY - 1)];
+		if (!peer->acked || snapshot->tick - peer->acked >= NET_HISTORY ||
+			base->tick != peer->acked)
+		{
+			base = &empty;
+			peer->full++;
+		}
+		bits_init(&bits, data, sizeof(data), 1);
+		bits_write(&bits, NET_PACKET_SERVER, 8);
+		bits_write(&bits, snapshot->tick, 32);
+		bits_write(&bits, base == &empty ? 0 : peer->acked, 32);
+		bits_write(&bits, server->tick_ms, 16);
+		snapshot_encode(&bits, base, snapshot);
+		if (bits.overflow)
+			continue;
+		udp_send(server->socket, &peer->address, data, BITS_BYTES(&bits));
+		peer->bytes += BITS_BYTES(&bits);
+		peer->packets++;
+	}
+}
+
+/**
+ * server_stop - Closes the server socket
+ * @server: Server
+ */
+void server_stop(Server *server)
+{
+	udp_close(server->socket);
+	server->socket = -1;
+}
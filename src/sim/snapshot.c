@@ -0,0 +1,185 @@
+#include "../../inc/net.h"
+#include <string.h>
+
+#define NET_POS_MAX ((1 << NET_POS_BITS) - 1)
+#define NET_TURN (1 << NET_ANGLE_BITS)
+#define NET_CLAMP8(v) ((v) < 0 ? 0 : (v) > 255 ? 255 : (Uint8)(v))
+/* Time of a shot or attack @age ticks before @tick; 0 if long ago */
+#define NET_SINCE(tick, age, tick_ms) ((age) >= NET_AGE_MAX || \
+	(age) > (tick) ? 0 : ((tick) - (age)) * (tick_ms))
+
+/**
+ * net_pos - Quantizes a maze coordinate
+ * @value: Coordinate in cells
+ * Return: Coordinate in 1/NET_POS_SCALE cells, clamped to NET_POS_BITS
+ */
+static Uint16 net_pos(float value)
+{
+	int q = (int)(value * NET_POS_SCALE + 0.5f);
+
+	return (q < 0 ? 0 : q > NET_POS_MAX ? NET_POS_MAX : q);
+}
+
+/**
+ * net_age - Counts the ticks since a shot or attack
+ * @weapon_system: Pointer to the WeaponSystem structure, for the time
+ * @time: When it happened, 0 for never
+ * Return: Whole ticks since @time, NET_AGE_MAX if never or longer ago
+ *
+ * The age of an old event stays at NET_AGE_MAX, so it is only sent
+ * again once a new one happens.
+ */
+static Uint8 net_age(const WeaponSystem *weapon_system, Uint32 time)
+{
+	Uint32 age;
+
+	if (time == 0 || time > weapon_system->time)
+		return (NET_AGE_MAX);
+	age = (weapon_system->time - time) / weapon_system->tick_ms;
+	return (age < NET_AGE_MAX ? age : NET_AGE_MAX);
+}
+
+/**
+ * snapshot_capture - Quantizes the simulation state after a tick
+ * @snapshot: Receives the state
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ */
+void snapshot_capture(Snapshot *snapshot, const GameState *game_state,
+		const Player *player, const WeaponSystem *weapon_system)
+{
+	float turns = player->angle / (2 * M_PI);
+	int i, x, y, doors = 0;
+
+	memset(snapshot, 0, sizeof(*snapshot));
+	snapshot->tick = game_state->tick;
+	snapshot->x = net_pos(player->x);
+	snapshot->y = net_pos(player->y);
+	snapshot->angle = (int)((turns - floorf(turns)) * NET_TURN + 0.5f) &
+		(NET_TURN - 1);
+	snapshot->score = weapon_system->score;
+	snapshot->health = NET_CLAMP8(weapon_system->player_health);
+	snapshot->enemy_count = NET_CLAMP8(weapon_system->enemy_count);
+	snapshot->shot_age = net_age(weapon_system, weapon_system->last_shot_time);
+	for (y = 0; y < MAZE_ROWS; y++)
+		for (x = 0; x < MAZE_COLS && doors < NET_MAX_DOORS; x++)
+			if (maze[y][x] == CELL_DOOR)
+				snapshot->doors[doors++] = door_open[y][x];
+	for (i = 0; i < MAX_ENEMIES; i++)
+	{
+		snapshot->enemies[i].x = net_pos(weapon_system->enemies[i].x);
+		snapshot->enemies[i].y = net_pos(weapon_system->enemies[i].y);
+		snapshot->enemies[i].alive = weapon_system->enemies[i].alive != 0;
+		snapshot->enemies[i].health =
+			NET_CLAMP8(weapon_system->enemies[i].health + 0.5f);
+		snapshot->enemies[i].attack_age = net_age(weapon_system,
+			weapon_system->enemies[i].last_attack);
+	}
+	for (i = 0; i < MAX_BULLETS; i++)
+		if (weapon_system->bullets[i].active)
+		{
+			snapshot->bullets[i].x = net_pos(weapon_system->bullets[i].x);
+			snapshot->bullets[i].y = net_pos(weapon_system->bullets[i].y);
+			snapshot->bullets[i].active = 1;
+		}
+}
+
+/**
+ * snapshot_apply - Sets up the state a renderer draws from a snapshot
+ * @snapshot: Snapshot to show
+ * @tick_ms: Server tick length
+ * @game_state: Receives the tick
+ * @player: Receives the player position and direction
+ * @weapon_system: Receives enemies, bullets and the HUD values
+ *
+ * Only what is drawn or heard is set; a client never steps the
+ * simulation. Shots and attacks are set back to the tick they happened
+ * on, or to 0 once older than NET_AGE_MAX ticks, so they only move
+ * forward when a new one happens. A bullet that stops keeps where it
+ * was last seen, and one that appears is taken as fired then.
+ */
+void snapshot_apply(const Snapshot *snapshot, Uint32 tick_ms,
+		GameState *game_state, Player *player, WeaponSystem *weapon_system)
+{
+	Bullet *bullet;
+	int i, x, y, doors = 0;
+
+	game_state->tick = snapshot->tick;
+	player->x = snapshot->x / NET_POS_SCALE;
+	player->y = snapshot->y / NET_POS_SCALE;
+	player->angle = snapshot->angle * 2 * M_PI / NET_TURN;
+	player->dx = cos(player->angle);
+	player->dy = sin(player->angle);
+	weapon_system->score = snapshot->score;
+	weapon_system->player_health = snapshot->health;
+	weapon_system->enemy_count = snapshot->enemy_count;
+	weapon_system->tick_ms = tick_ms;
+	weapon_system->time = snapshot->tick * tick_ms;
+	weapon_system->last_shot_time = NET_SINCE(snapshot->tick,
+		snapshot->shot_age, tick_ms);
+	for (y = 0; y < MAZE_ROWS; y++)
+		for (x = 0; x < MAZE_COLS && doors < NET_MAX_DOORS; x++)
+			if (maze[y][x] == CELL_DOOR)
+				door_open[y][x] = snapshot->doors[doors++];
+	for (i = 0; i < MAX_ENEMIES; i++)
+	{
+		weapon_system->enemies[i].x = snapshot->enemies[i].x / NET_POS_SCALE;
+		weapon_system->enemies[i].y = snapshot->enemies[i].y / NET_POS_SCALE;
+		weapon_system->enemies[i].alive = snapshot->enemies[i].alive;
+		weapon_system->enemies[i].health = snapshot->enemies[i].health;
+		weapon_system->enemies[i].last_attack = NET_SINCE(snapshot->tick,
+			snapshot->enemies[i].attack_age, tick_ms);
+	}
+	for (i = 0, bullet = weapon_system->bullets; i < MAX_BULLETS; i++, bullet++)
+		if (snapshot->bullets[i].active)
+		{
+			bullet->created = bullet->active ? bullet->created :
+				weapon_system->time;
+			bullet->x = snapshot->bullets[i].x / NET_POS_SCALE;
+			bullet->y = snapshot->bullets[i].y / NET_POS_SCALE;
+			bullet->active = 1;
+		}
+		else
+			bullet->active = 0;
+}
+
+/**
+ * snapshot_lerp - Moves things between two snapshots
+ * @a: Earlier snapshot, already applied with snapshot_apply()
+ * @b: Later snapshot
+ * @t: Fraction of the way from @a to @b, 0 to 1
+ * @player: Player to move
+ * @weapon_system: Enemies and bullets to move
+ *
+ * Only positions and the view angle are blended; enemies and bullets
+ * that appear or vanish in between keep @a's state until @b is reached.
+ */
+void snapshot_lerp(const Snapshot *a, const Snapshot *b, float t,
+		Player *player, WeaponSystem *weapon_system)
+{
+	int i, turn = ((b->angle - a->angle + NET_TURN / 2) & (NET_TURN - 1)) -
+		NET_TURN / 2;
+
+	player->x = (a->x + (b->x - a->x) * t) / NET_POS_SCALE;
+	player->y = (a->y + (b->y - a->y) * t) / NET_POS_SCALE;
+	player->angle = (a->angle + turn * t) * 2 * M_PI / NET_TURN;
+	player->dx = cos(player->angle);
+	player->dy = sin(player->angle);
+	for (i = 0; i < MAX_ENEMIES; i++)
+		if (a->enemies[i].alive && b->enemies[i].alive)
+		{
+			weapon_system->enemies[i].x = (a->enemies[i].x +
+				(b->enemies[i].x - a->enemies[i].x) * t) / NET_POS_SCALE;
+			weapon_system->enemies[i].y = (a->enemies[i].y +
+				(b->enemies[i].y - a->enemies[i].y) * t) / NET_POS_SCALE;
+		}
+	for (i = 0; i < MAX_BULLETS; i++)
+		if (a->bullets[i].active && b->bullets[i].active)
+		{
+			weapon_system->bullets[i].x = (a->bullets[i].x +
+				(b->bullets[i].x - a->bullets[i].x) * t) / NET_POS_SCALE;
+			weapon_system->bullets[i].y = (a->bullets[i].y +
+				(b->bullets[i].y - a->bullets[i].y) * t) / NET_POS_SCALE;
+		}
+}
@@ -0,0 +1,125 @@
+#include "../../inc/maze.h"
+
+/**
+ * sweep_walls - Finds where a moving point first enters a blocking cell
+ * @maze: Maze layout
+ * @x0: Start X
+ * @y0: Start Y
+ * @x1: End X
+ * @y1: End Y
+ * Return: Fraction of the segment travelled when it enters the first
+ * blocking cell (walls, grates, closed doors), 0 if it starts in one,
+ * SWEEP_CLEAR if none is crossed
+ *
+ * Walks every cell the segment passes through with a grid DDA, like
+ * pvs_segment_clear(), so a fast bullet cannot step over a wall corner.
+ */
+float sweep_walls(const int maze[15][15], float x0, float y0,
+			float x1, float y1)
+{
+	int cx = (int)x0, cy = (int)y0, steps;
+	float dx = x1 - x0, dy = y1 - y0, t;
+	float step_x = dx != 0 ? fabsf(1.0f / dx) : 1e30f;
+	float step_y = dy != 0 ? fabsf(1.0f / dy) : 1e30f;
+	float next_x = 1e30f, next_y = 1e30f;
+
+	if (x0 < 0 || y0 < 0 || cx >= MAZE_COLS || cy >= MAZE_ROWS ||
+		cell_blocks(maze, cx, cy))
+		return (0);
+	if (dx != 0)
+		next_x = (dx > 0 ? cx + 1 - x0 : x0 - cx) * step_x;
+	if (dy != 0)
+		next_y = (dy > 0 ? cy + 1 - y0 : y0 - cy) * step_y;
+	for (steps = 0; steps < MAZE_COLS + MAZE_ROWS; steps++)
+	{
+		t = next_x < next_y ? next_x : next_y;
+		if (t > 1.0f)
+			return (SWEEP_CLEAR);
+		if (next_x < next_y)
+		{
+			next_x += step_x;
+			cx += dx > 0 ? 1 : -1;
+		}
+		else
+		{
+			next_y += step_y;
+			cy += dy > 0 ? 1 : -1;
+		}
+		if (cx < 0 || cy < 0 || cx >= MAZE_COLS || cy >= MAZE_ROWS ||
+			cell_blocks(maze, cx, cy))
+			return (t);
+	}
+	return (SWEEP_CLEAR);
+}
+
+/**
+ * sweep_circle - Finds where a moving point first touches a circle
+ * @x0: Start X
+ * @y0: Start Y
+ * @x1: End X
+ * @y1: End Y
+ * @cx: Circle center X
+ * @cy: Circle center Y
+ * @radius: Circle radius
+ * Return: Fraction of the segment travelled at the first contact, 0 if
+ * the start is inside the circle, SWEEP_CLEAR if they never touch
+ */
+float sweep_circle(float x0, float y0, float x1, float y1,
+		float cx, float cy, float radius)
+{
+	float dx = x1 - x0, dy = y1 - y0, fx = x0 - cx, fy = y0 - cy;
+	float a = dx * dx + dy * dy, b = fx * dx + fy * dy;
+	float c = fx * fx + fy * fy - radius * radius, t;
+
+	if (c < 0)
+		return (0);
+	if (a == 0 || b >= 0 || b * b - a * c < 0)
+		return (SWEEP_CLEAR); /* Standing still, moving away or passing by */
+	t = (-b - sqrtf(b * b - a * c)) / a;
+	return (t <= 1 ? t : SWEEP_CLEAR);
+}
+
+/**
+ * sweep_cells - Lists the cells a segment passes through
+ * @x0: Start X
+ * @y0: Start Y
+ * @x1: End X
+ * @y1: End Y
+ * @cells: Receives up to SWEEP_CELLS cell indices (y * MAZE_COLS + x),
+ * in the order the segment enters them
+ * Return: Number of cells listed
+ *
+ * The same grid DDA as sweep_walls(), without stopping at walls; the
+ * list ends where the segment does or where it leaves the maze.
+ */
+int sweep_cells(float x0, float y0, float x1, float y1, int *cells)
+{
+	int cx = (int)floorf(x0), cy = (int)floorf(y0), count = 0;
+	float dx = x1 - x0, dy = y1 - y0;
+	float step_x = dx != 0 ? fabsf(1.0f / dx) : 1e30f;
+	float step_y = dy != 0 ? fabsf(1.0f / dy) : 1e30f;
+	float next_x = 1e30f, next_y = 1e30f;
+
+	if (dx != 0)
+		next_x = (dx > 0 ? cx + 1 - x0 : x0 - cx) * step_x;
+	if (dy != 0)
+		next_y = (dy > 0 ? cy + 1 - y0 : y0 - cy) * step_y;
+	while (count < SWEEP_CELLS && cx >= 0 && cy >= 0 &&
+		cx < MAZE_COLS && cy < MAZE_ROWS)
+	{
+		cells[count++] = cy * MAZE_COLS + cx;
+		if ((next_x < next_y ? next_x : next_y) > 1.0f)
+			break;
+		if (next_x < next_y)
+		{
+			next_x += step_x;
+			cx += dx > 0 ? 1 : -1;
+		}
+		else
+		{
+			next_y += step_y;
+			cy += dy > 0 ? 1 : -1;
+		}
+	}
+	return (count);
+}
@@ -0,0 +1,110 @@
+#include "../../inc/net.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * udp_open - Opens a non-blocking UDP socket
+ * @port: Port to bind; 0 picks a free one. Receives the bound port
+ * Return: Socket, or -1 on failure
+ */
+int udp_open(int *port)
+{
+	struct sockaddr_in address;
+	socklen_t length = sizeof(address);
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	if (fd < 0)
+		return (-1);
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(*port);
+	if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+		fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0 ||
+		getsockname(fd, (struct sockaddr *)&address, &length) != 0)
+	{
+		printf("UDP port %d: %s\n", *port, strerror(errno));
+		close(fd);
+		return (-1);
+	}
+	*port = ntohs(address.sin_port);
+	return (fd);
+}
+
+/**
+ * udp_resolve - Parses a server address
+ * @text: "a.b.c.d:port", or just a port on this machine
+ * @address: Receives the address
+ * Return: 0 on success, -1 if @text is not an address or its port is
+ * not entirely a number from 1 to 65535
+ */
+int udp_resolve(const char *text, struct sockaddr_in *address)
+{
+	const char *colon = strrchr(text, ':');
+	char host[64] = "127.0.0.1", *end;
+	long port;
+
+	if (colon && (size_t)(colon - text) < sizeof(host))
+	{
+		memcpy(host, text, colon - text);
+		host[colon - text] = '\0';
+		text = colon + 1;
+	}
+	errno = 0;
+	port = strtol(text, &end, 10);
+	if (end == text || *end != '\0' || errno == ERANGE)
+		return (-1);
+	memset(address, 0, sizeof(*address));
+	address->sin_family = AF_INET;
+	address->sin_port = htons(port);
+	if (port <= 0 || port > 65535 ||
+		inet_pton(AF_INET, host, &address->sin_addr) != 1)
+		return (-1);
+	return (0);
+}
+
+/**
+ * udp_send - Sends one datagram
+ * @socket: UDP socket
+ * @to: Destination
+ * @data: Bytes to send
+ * @size: Number of bytes
+ *
+ * Failures are ignored; to the receiver they look like packet loss.
+ */
+void udp_send(int socket, const struct sockaddr_in *to, const Uint8 *data,
+		int size)
+{
+	sendto(socket, data, size, 0, (const struct sockaddr *)to, sizeof(*to));
+}
+
+/**
+ * udp_receive - Takes the next waiting datagram, if any
+ * @socket: UDP socket
+ * @from: Receives the sender
+ * @data: Receives the bytes
+ * @size: Size of @data
+ * Return: Bytes received, -1 if nothing is waiting
+ */
+int udp_receive(int socket, struct sockaddr_in *from, Uint8 *data, int size)
+{
+	socklen_t length = sizeof(*from);
+	ssize_t got = recvfrom(socket, data, size, 0, (struct sockaddr *)from,
+		&length);
+
+	return (got < 0 ? -1 : (int)got);
+}
+
+/**
+ * udp_close - Closes a socket
+ * @socket: UDP socket, or -1
+ */
+void udp_close(int socket)
+{
+	if (socket >= 0)
+		close(socket);
+}
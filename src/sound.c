@@ -0,0 +1,90 @@
+#include "../inc/audio.h"
+
+/**
+ * struct Tone - Recipe of a synthesized sound
+ * @seconds: Length
+ * @start_hz: Pitch at the start
+ * @end_hz: Pitch at the end; it slides linearly in between
+ * @noise: Share of white noise, 0 to 1
+ * @square: 1 for a square wave, 0 for a sine
+ * @decay: Exponential decay of the envelope per second
+ * @level: Peak amplitude, 0 to 1
+ */
+struct Tone
+{
+	float seconds;
+	float start_hz;
+	float end_hz;
+	float noise;
+	int square;
+	float decay;
+	float level;
+};
+
+/* Recipes by SOUND_* number */
+static const struct Tone tones[SOUND_COUNT] = {
+	{0.18f, 180.0f, 50.0f, 0.7f, 0, 18.0f, 0.8f},  /* Shot: burst and thump */
+	{0.08f, 900.0f, 600.0f, 0.1f, 1, 30.0f, 0.35f}, /* Hit: short blip */
+	{0.30f, 110.0f, 70.0f, 0.2f, 1, 6.0f, 0.5f},   /* Attack: growl */
+	{0.50f, 440.0f, 70.0f, 0.05f, 0, 5.0f, 0.6f}   /* Death: falling tone */
+};
+
+/**
+ * sounds_build - Synthesizes every sound into PCM
+ * @sounds: Receives SOUND_COUNT sounds
+ * Return: 0 on success, -1 on allocation failure
+ *
+ * The game ships no sound files; the sounds are made once at startup,
+ * the same every run, and then only read by the mixer.
+ */
+int sounds_build(Sound *sounds)
+{
+	const struct Tone *tone;
+	float t, hz, phase, wave, envelope;
+	Rng rng;
+	int s, i;
+
+	rng_seed(&rng, 1);
+	for (s = 0; s < SOUND_COUNT; s++)
+	{
+		tone = &tones[s];
+		sounds[s].length = (int)(tone->seconds * AUDIO_RATE);
+		sounds[s].pcm = malloc(sizeof(Sint16) * sounds[s].length);
+		if (!sounds[s].pcm)
+		{
+			sounds_free(sounds);
+			return (-1);
+		}
+		for (i = 0, phase = 0.0f; i < sounds[s].length; i++)
+		{
+			t = (float)i / AUDIO_RATE;
+			hz = tone->start_hz + (tone->end_hz - tone->start_hz) * t /
+				tone->seconds;
+			phase += 2.0f * (float)M_PI * hz / AUDIO_RATE;
+			wave = sinf(phase);
+			if (tone->square)
+				wave = wave >= 0.0f ? 1.0f : -1.0f;
+			wave = wave * (1.0f - tone->noise) +
+				(rng_float(&rng) * 2.0f - 1.0f) * tone->noise;
+			/* A 5 ms attack keeps the start from clicking */
+			envelope = expf(-tone->decay * t) * (t < 0.005f ? t / 0.005f : 1.0f);
+			sounds[s].pcm[i] = (Sint16)(32767.0f * tone->level * envelope * wave);
+		}
+	}
+	return (0);
+}
+
+/**
+ * sounds_free - Frees sounds made by sounds_build()
+ * @sounds: SOUND_COUNT sounds; missing ones are NULL
+ */
+void sounds_free(Sound *sounds)
+{
+	int s;
+
+	for (s = 0; s < SOUND_COUNT; s++)
+	{
+		free(sounds[s].pcm);
+		sounds[s].pcm = NULL;
+	}
+}
@@ -0,0 +1,99 @@
+#include "../inc/text.h"
+#include <stdio.h>
+
+/**
+ * text_init - Builds the glyph atlas and the batch's index buffer
+ * @batch: Batch to initialize
+ * @renderer: SDL renderer the text is drawn with
+ * Return: 0 on success, -1 if the atlas could not be created
+ */
+int text_init(TextBatch *batch, SDL_Renderer *renderer)
+{
+	int i;
+
+	for (i = 0; i < TEXT_MAX_GLYPHS; i++)
+	{
+		batch->indices[i * 6] = i * 4;
+		batch->indices[i * 6 + 1] = i * 4 + 1;
+		batch->indices[i * 6 + 2] = i * 4 + 2;
+		batch->indices[i * 6 + 3] = i * 4 + 2;
+		batch->indices[i * 6 + 4] = i * 4 + 3;
+		batch->indices[i * 6 + 5] = i * 4;
+	}
+	batch->glyphs = 0;
+	batch->atlas = font_atlas(renderer);
+	if (!batch->atlas)
+	{
+		printf("Font atlas creation failed: %s\n", SDL_GetError());
+		return (-1);
+	}
+	return (0);
+}
+
+/**
+ * text_add - Queues a string for the next text_flush()
+ * @batch: Text batch
+ * @x: Left edge in pixels
+ * @y: Top edge in pixels
+ * @scale: Pixels per font texel
+ * @color: Text color
+ * @string: Text; lowercase is drawn as uppercase, unknown characters as '?'
+ * Return: Width of the string in pixels
+ *
+ * Glyphs past TEXT_MAX_GLYPHS in one batch are dropped.
+ */
+int text_add(TextBatch *batch, int x, int y, int scale, SDL_Color color,
+		const char *string)
+{
+	SDL_Vertex *v;
+	float u, t, w = FONT_WIDTH * scale, h = FONT_HEIGHT * scale;
+	int c, left = x;
+
+	for (; *string; string++, x += FONT_CELL_W * scale)
+	{
+		c = *string >= 'a' && *string <= 'z' ? *string - 'a' + 'A' : *string;
+		c = c < FONT_FIRST || c >= FONT_FIRST + FONT_GLYPHS ? '?' : c;
+		if (c == ' ' || batch->glyphs == TEXT_MAX_GLYPHS)
+			continue;
+		c -= FONT_FIRST;
+		u = (float)(c % FONT_ATLAS_COLS * FONT_CELL_W) / FONT_ATLAS_W;
+		t = (float)(c / FONT_ATLAS_COLS * FONT_CELL_H) / FONT_ATLAS_H;
+		v = &batch->vertices[batch->glyphs++ * 4];
+		v[0].position.x = v[3].position.x = x;
+		v[1].position.x = v[2].position.x = x + w;
+		v[0].position.y = v[1].position.y = y;
+		v[2].position.y = v[3].position.y = y + h;
+		v[0].tex_coord.x = v[3].tex_coord.x = u;
+		v[1].tex_coord.x = v[2].tex_coord.x =
+			u + (float)FONT_WIDTH / FONT_ATLAS_W;
+		v[0].tex_coord.y = v[1].tex_coord.y = t;
+		v[2].tex_coord.y = v[3].tex_coord.y =
+			t + (float)FONT_HEIGHT / FONT_ATLAS_H;
+		v[0].color = v[1].color = v[2].color = v[3].color = color;
+	}
+	return (x - left);
+}
+
+/**
+ * text_flush - Draws every queued glyph with a single geometry call
+ * @batch: Text batch; empty afterwards
+ * @renderer: SDL renderer
+ */
+void text_flush(TextBatch *batch, SDL_Renderer *renderer)
+{
+	if (batch->glyphs > 0 && batch->atlas)
+		SDL_RenderGeometry(renderer, batch->atlas, batch->vertices,
+			batch->glyphs * 4, batch->indices, batch->glyphs * 6);
+	batch->glyphs = 0;
+}
+
+/**
+ * text_cleanup - Frees the glyph atlas
+ * @batch: Text batch
+ */
+void text_cleanup(TextBatch *batch)
+{
+	if (batch->atlas)
+		SDL_DestroyTexture(batch->atlas);
+	batch->atlas = NULL;
+}
@@ -1,4 +1,5 @@
 #include "../inc/maze.h"
+#include <string.h>
 
 /**
  * load_texture - Load a texture from a PNG file
@@ -46,12 +47,40 @@ static Uint32 *load_texture(const char *path)
 	return (pixels);
 }
 
+/**
+ * create_grate - Generates the grate texture
+ * Return: Pixel data with transparent holes between the bars, or NULL
+ *
+ * Vertical bars every 16 texels with rails at the top, middle and bottom;
+ * each bar is shaded across its width so it reads as round.
+ */
+static Uint32 *create_grate(void)
+{
+	Uint32 *pixels = malloc(TEXTURE_SIZE * TEXTURE_SIZE * sizeof(Uint32));
+	int x, y, bar, rail, shade;
+
+	if (!pixels)
+		return (NULL);
+	for (y = 0; y < TEXTURE_SIZE; y++)
+		for (x = 0; x < TEXTURE_SIZE; x++)
+		{
+			bar = (x + 2) % 16 < 4;
+			rail = y % 30 < 4;
+			shade = 70 + 30 * (bar ? (x + 2) % 16 : y % 30);
+			pixels[y * TEXTURE_SIZE + x] = bar || rail ?
+				0xFF000000u | (Uint32)shade << 16 | (Uint32)shade << 8 |
+				(Uint32)(shade + 20) : 0;
+		}
+	return (pixels);
+}
+
 /**
  * init_textures - Initialize wall and floor textures
  * @textures: Pointer to the Textures structure to be initialized
+ * @fog: Fog color distant surfaces are shaded towards
  * Return: 0 on success, -1 on failure
  */
-int init_textures(Textures *textures)
+int init_textures(Textures *textures, Uint32 fog)
 {
 	/* Initialize SDL_image */
 	int flags = IMG_Init(IMG_INIT_PNG);
@@ -63,6 +92,7 @@ int init_textures(Textures *textures)
 	}
 
 	/* Set texture dimensions */
+	memset(textures, 0, sizeof(*textures));
 	(*textures).width = TEXTURE_SIZE;
 	(*textures).height = TEXTURE_SIZE;
 
@@ -70,10 +100,13 @@ int init_textures(Textures *textures)
 	(*textures).north_south = load_texture("textures/greystone.png");
 	(*textures).east_west = load_texture("textures/mossy.png");
 	(*textures).floor = load_texture("textures/wood.png");
+	(*textures).grate = create_grate();
 
-	if (!(*textures).north_south || !(*textures).east_west || !(*textures).floor)
+	if (!(*textures).north_south || !(*textures).east_west ||
+		!(*textures).floor || !(*textures).grate ||
+		shade_textures(textures, fog) != 0)
 	{
-		IMG_Quit();
+		cleanup_textures(textures);
 		return (-1);
 	}
 
@@ -89,5 +122,11 @@ void cleanup_textures(Textures *textures)
 	free((*textures).north_south);
 	free((*textures).east_west);
 	free((*textures).floor);
+	free((*textures).grate);
+	free((*textures).ns_shades);
+	free((*textures).ew_shades);
+	free((*textures).floor_shades);
+	free((*textures).ceiling_shades);
+	free((*textures).grate_shades);
 	IMG_Quit();
 }
@@ -0,0 +1,148 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+
+#define BEHAVIOUR_BENCH_TICKS 2000 /* Ticks run per behaviour count */
+#define BEHAVIOUR_BENCH_SIGNAL 64  /* One in this many enemies gets an event */
+
+/**
+ * bench_alloc - Allocates a scheduler and enemies and starts the scripts
+ * @scheduler: Receives the arrays
+ * @enemies: Receives the enemies, spread over the open cells
+ * @count: Number of enemies and behaviours
+ * @rng: Random number generator
+ * Return: 0 on success, -1 on allocation failure
+ *
+ * Scripts go round BEHAVIOUR_SCRIPTS by index, as in the game.
+ */
+static int bench_alloc(Scheduler *scheduler, Enemy **enemies, int count,
+		Rng *rng)
+{
+	static int wheel[SCHED_WHEEL], ready_count;
+	int i, x, y;
+
+	scheduler->behaviours = calloc(count, sizeof(Behaviour));
+	scheduler->count = count;
+	scheduler->next = calloc(count, sizeof(int));
+	scheduler->prev = calloc(count, sizeof(int));
+	scheduler->wheel = wheel;
+	scheduler->ready = calloc(count, sizeof(int));
+	scheduler->ready_count = &ready_count;
+	*enemies = calloc(count, sizeof(Enemy));
+	if (!scheduler->behaviours || !scheduler->next || !scheduler->prev ||
+		!scheduler->ready || !*enemies)
+		return (-1);
+	scheduler_reset(scheduler);
+	for (i = 0; i < count; i++)
+	{
+		do {
+			x = rng_next(rng) % MAZE_COLS;
+			y = rng_next(rng) % MAZE_ROWS;
+		} while (maze[y][x] != CELL_EMPTY);
+		(*enemies)[i].x = x + 0.5f;
+		(*enemies)[i].y = y + 0.5f;
+		(*enemies)[i].alive = 1;
+		scheduler->behaviours[i].script = i % BEHAVIOUR_SCRIPTS;
+		scheduler->behaviours[i].wait = BEHAVIOUR_START;
+		scheduler_signal(scheduler, i, BEHAVIOUR_START);
+	}
+	scheduler_run(scheduler, *enemies, 0, TICK_MS);
+	return (0);
+}
+
+/**
+ * bench_signal - Raises the events of one benchmark tick
+ * @scheduler: Scheduler
+ * @rng: Random number generator
+ *
+ * Stands in for the entity merges: random enemies are hurt, come near
+ * or reach their goal. A script that ran to its end is started again,
+ * as if its enemy respawned, so the mix of waits stays steady.
+ */
+static void bench_signal(Scheduler *scheduler, Rng *rng)
+{
+	static const Uint8 events[4] = {BEHAVIOUR_ARRIVED, BEHAVIOUR_ARRIVED,
+		BEHAVIOUR_HURT, BEHAVIOUR_NEAR};
+	Behaviour *co;
+	int n, i;
+
+	for (n = 0; n < scheduler->count / BEHAVIOUR_BENCH_SIGNAL; n++)
+	{
+		i = rng_next(rng) % scheduler->count;
+		co = &scheduler->behaviours[i];
+		if (co->line == BEHAVIOUR_DONE)
+		{
+			co->line = 0;
+			co->wait |= BEHAVIOUR_START;
+			scheduler_signal(scheduler, i, BEHAVIOUR_START);
+			continue;
+		}
+		scheduler_signal(scheduler, i, events[rng_next(rng) % 4]);
+	}
+}
+
+/**
+ * bench_round - Runs one behaviour count and prints a row
+ * @count: Number of behaviours
+ * Return: 0 on success, -1 on allocation failure
+ */
+static int bench_round(int count)
+{
+	Scheduler scheduler;
+	Enemy *enemies = NULL;
+	Rng rng;
+	Uint64 start, spent = 0;
+	long resumed = 0;
+	double us;
+	int status, tick;
+
+	rng_seed(&rng, 1);
+	status = bench_alloc(&scheduler, &enemies, count, &rng);
+	for (tick = 1; tick <= BEHAVIOUR_BENCH_TICKS && status == 0; tick++)
+	{
+		start = SDL_GetPerformanceCounter();
+		bench_signal(&scheduler, &rng);
+		resumed += scheduler_run(&scheduler, enemies, tick, TICK_MS);
+		spent += SDL_GetPerformanceCounter() - start;
+	}
+	us = spent * 1e6 / SDL_GetPerformanceFrequency() / BEHAVIOUR_BENCH_TICKS;
+	if (status == 0)
+		printf("%10d %13.1f %8.2f %10.1f %13.2f\n", count,
+			(double)resumed / BEHAVIOUR_BENCH_TICKS, us,
+			resumed > 0 ? us * 1000.0 * BEHAVIOUR_BENCH_TICKS / resumed : 0.0,
+			us * 1000.0 / count);
+	free(scheduler.behaviours);
+	free(scheduler.next);
+	free(scheduler.prev);
+	free(scheduler.ready);
+	free(enemies);
+	return (status);
+}
+
+/**
+ * run_behaviour_bench - Measures the scheduler from 1024 behaviours up
+ * @max_count: Largest behaviour count; 1024, 4096... up to it are run
+ * Return: 0 on success, 1 on allocation failure
+ *
+ * Every tick one enemy in BEHAVIOUR_BENCH_SIGNAL gets an event and the
+ * timers due run out; every other behaviour stays suspended, which
+ * should cost nothing, so the time per tick follows the scripts resumed
+ * rather than the behaviours alive.
+ */
+int run_behaviour_bench(int max_count)
+{
+	int count, status = 0;
+
+	printf("Behaviour scheduler, %d ticks at %u ms, 1 in %d enemies"
+		" signalled per tick\nbehaviours  resumed/tick  us/tick"
+		"  ns/resume  ns/behaviour\n", BEHAVIOUR_BENCH_TICKS,
+		(unsigned int)TICK_MS, BEHAVIOUR_BENCH_SIGNAL);
+	for (count = 1024; status == 0; count *= 4)
+	{
+		if (count > max_count)
+			count = max_count;
+		status = bench_round(count);
+		if (count == max_count)
+			break;
+	}
+	return (status != 0);
+}
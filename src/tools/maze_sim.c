@@ -0,0 +1,295 @@
+#include "../../inc/maze.h"
+#include "../../inc/weapon_sprites.h"
+#include "../../inc/net.h"
+#include "../../inc/save.h"
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#define SIM_DEFAULT_TICKS 100000
+#define SAVE_BENCH_ROUNDS 100000 /* Save/load round trips --bench-save times */
+#define BENCH_BEHAVIOURS_MAX (1 << 22) /* Most --bench-behaviours takes */
+
+/**
+ * struct SimArgs - Command line of maze_sim
+ * @ticks: Ticks to run
+ * @seed: Seed of the game RNG; the bot's inputs derive from it too
+ * @tick_ms: Simulation tick length
+ * @record: Replay file to record the applied input to, or NULL
+ * @serve: UDP port to serve clients on in real time, 0 to run the bot
+ * @bench_net: Largest client count of the snapshot benchmark, or 0
+ * @load: Save to start from instead of the seed, or NULL
+ * @save: File to save the final state to, or NULL
+ * @bench_save: 1 to time saving and loading the final state
+ * @bench_behaviours: Largest count of the behaviour benchmark, or 0
+ */
+typedef struct SimArgs
+{
+	long ticks;
+	Uint32 seed;
+	Uint32 tick_ms;
+	const char *record;
+	int serve;
+	int bench_net;
+	const char *load;
+	const char *save;
+	int bench_save;
+	int bench_behaviours;
+} SimArgs;
+
+/**
+ * parse_value - Reads a whole command line value as a number
+ * @text: Value text, decimal or with a 0x or 0 prefix
+ * @value: Receives the value
+ * Return: 0 on success, -1 if @text is not entirely a number that is not
+ * negative and fits an unsigned long
+ */
+static int parse_value(const char *text, unsigned long *value)
+{
+	char *end;
+
+	errno = 0;
+	*value = strtoul(text, &end, 0);
+	/* strtoul() quietly wraps a negative number around, so any '-' fails */
+	return (end == text || *end != '\0' || errno == ERANGE ||
+		strchr(text, '-') ? -1 : 0);
+}
+
+/**
+ * parse_args - Reads maze_sim's command line
+ * @argc: Argument count
+ * @argv: Argument vector
+ * @args: Receives the settings
+ * Return: 0 to run, 1 after printing help, -1 on a bad argument
+ *
+ * A number must be the whole value and within the option's range, or the
+ * option is reported as bad.
+ */
+static int parse_args(int argc, char **argv, SimArgs *args)
+{
+	unsigned long value;
+	int i, number;
+
+	memset(args, 0, sizeof(*args));
+	args->ticks = SIM_DEFAULT_TICKS;
+	args->seed = (Uint32)time(NULL);
+	args->tick_ms = TICK_MS;
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--help") == 0)
+		{
+			printf("Usage: %s [--ticks N] [--seed N] [--tick-rate N]"
+				" [--record FILE]\n"
+				"       [--serve PORT] [--bench-net CLIENTS] [--load FILE]"
+				" [--save FILE]\n       [--bench-save 1] [--bench-behaviours N]\n"
+				"Runs the simulation headlessly with a random bot as fast as"
+				" it can,\nor in real time for clients of maze_game --connect"
+				" (--serve).\n", argv[0]);
+			return (1);
+		}
+		if (i + 1 == argc)
+			break;
+		number = parse_value(argv[i + 1], &value) == 0;
+		if (strcmp(argv[i], "--ticks") == 0 && number && value > 0 &&
+			value <= LONG_MAX)
+			args->ticks = value;
+		else if (strcmp(argv[i], "--seed") == 0 && number &&
+			value <= 0xFFFFFFFFUL)
+			args->seed = (Uint32)value;
+		else if (strcmp(argv[i], "--tick-rate") == 0 && number && value > 0 &&
+			value <= 1000)
+			args->tick_ms = TICK_MS_AT(value);
+		else if (strcmp(argv[i], "--record") == 0)
+			args->record = argv[i + 1];
+		else if (strcmp(argv[i], "--serve") == 0 && number && value > 0 &&
+			value < 65536)
+			args->serve = value;
+		else if (strcmp(argv[i], "--bench-net") == 0 && number && value > 0 &&
+			value <= NET_MAX_CLIENTS)
+			args->bench_net = value;
+		else if (strcmp(argv[i], "--load") == 0)
+			args->load = argv[i + 1];
+		else if (strcmp(argv[i], "--save") == 0)
+			args->save = argv[i + 1];
+		else if (strcmp(argv[i], "--bench-save") == 0 && number && value <= 1)
+			args->bench_save = value;
+		else if (strcmp(argv[i], "--bench-behaviours") == 0 && number &&
+			value > 0 && value <= BENCH_BEHAVIOURS_MAX)
+			args->bench_behaviours = value;
+		else
+			break;
+		i++;
+	}
+	if (i == argc)
+		return (0);
+	printf("Bad argument %s (try --help)\n", argv[i]);
+	return (-1);
+}
+
+/**
+ * serve - Runs the simulation in real time for network clients
+ * @args: Command line; --ticks limits the run
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * @replay: Records the input the clients sent, if --record was given
+ * Return: 0 on success, -1 if the port could not be opened
+ *
+ * Prints the client count, bytes sent per client and the server's cost
+ * per tick once a second.
+ */
+static int serve(const SimArgs *args, GameState *game_state, Player *player,
+		WeaponSystem *weapon_system, Replay *replay)
+{
+	Server server;
+	Snapshot snapshot;
+	Input input;
+	Uint32 next, report, sent, before = 0;
+	Uint64 start, spent = 0;
+	long tick, ticks = 0;
+	int i, clients;
+
+	if (server_start(&server, args->serve, args->tick_ms) != 0)
+		return (-1);
+	printf("Serving on UDP port %d, %u ms per tick\n", server.port,
+		(unsigned int)args->tick_ms);
+	next = report = SDL_GetTicks();
+	for (tick = 0; tick < args->ticks; tick++)
+	{
+		while (!SDL_TICKS_PASSED(SDL_GetTicks(), next))
+			SDL_Delay(1);
+		next += args->tick_ms;
+		start = SDL_GetPerformanceCounter();
+		server_receive(&server, game_state->tick + 1, &input);
+		step_game(game_state, player, weapon_system, replay, &input);
+		snapshot_capture(&snapshot, game_state, player, weapon_system);
+		server_send(&server, &snapshot);
+		spent += SDL_GetPerformanceCounter() - start;
+		ticks++;
+		if (!SDL_TICKS_PASSED(SDL_GetTicks(), report + 1000))
+			continue;
+		for (i = clients = 0, sent = 0; i < NET_MAX_CLIENTS; i++)
+		{
+			clients += server.peers[i].active;
+			sent += server.peers[i].bytes;
+		}
+		printf("%d clients, %u bytes/s per client, %.3f ms per tick\n",
+			clients, clients ? (unsigned int)((sent - before) / clients) : 0,
+			spent * 1000.0 / SDL_GetPerformanceFrequency() / ticks);
+		report = SDL_GetTicks();
+		before = sent;
+		spent = ticks = 0;
+	}
+	server_stop(&server);
+	return (0);
+}
+
+/**
+ * bench_save - Times saving and loading the current state
+ * @game_state: Pointer to the GameState structure
+ * @player: Pointer to the player
+ * @weapon_system: Pointer to the WeaponSystem structure
+ * Return: 0 if every load gave back the saved state, -1 otherwise
+ */
+static int bench_save(GameState *game_state, Player *player,
+		WeaponSystem *weapon_system)
+{
+	Uint8 data[SAVE_MAX];
+	Uint32 hash = game_state_hash(game_state, player, weapon_system);
+	Uint64 start, saving = 0, loading = 0;
+	double scale = 1e6 / SDL_GetPerformanceFrequency() / SAVE_BENCH_ROUNDS;
+	size_t size = 0;
+	int i, status = 0;
+
+	for (i = 0; i < SAVE_BENCH_ROUNDS; i++)
+	{
+		start = SDL_GetPerformanceCounter();
+		size = save_state(data, sizeof(data), game_state, player,
+			weapon_system);
+		saving += SDL_GetPerformanceCounter() - start;
+		start = SDL_GetPerformanceCounter();
+		status |= load_state(data, size, game_state, player, weapon_system);
+		loading += SDL_GetPerformanceCounter() - start;
+	}
+	if (status == 0 && hash != game_state_hash(game_state, player,
+		weapon_system))
+		status = -1;
+	printf("Save of %lu bytes: %.2f us to save, %.2f us to load: %s\n",
+		(unsigned long)size, saving * scale, loading * scale,
+		status ? "MISMATCH" : "identical");
+	return (status);
+}
+
+/**
+ * main - Runs the simulation headlessly, without a window or renderer
+ * @argc: Argument count
+ * @argv: Argument vector
+ * Return: 0 on success, 1 on failure
+ *
+ * Uses the same library and step as maze_game, so a run recorded with
+ * --record plays back identically in maze_game --replay.
+ */
+int main(int argc, char **argv)
+{
+	static GameState game_state;
+	static WeaponSystem weapon_system;
+	Player player;
+	Replay replay;
+	SimArgs args;
+	Input input = {0};
+	Bot bot;
+	int status = parse_args(argc, argv, &args);
+	Uint64 start;
+	double ms;
+	long tick;
+
+	if (status != 0)
+		return (status < 0);
+	if (args.bench_net)
+		return (run_net_bench(args.bench_net, args.seed, args.tick_ms));
+	if (args.bench_behaviours)
+		return (run_behaviour_bench(args.bench_behaviours));
+	if (args.load && args.record)
+	{
+		printf("--load cannot be combined with --record\n");
+		return (1);
+	}
+	game_init(&game_state, &player, &weapon_system, args.seed);
+	if (args.load && load_file(args.load, &game_state, &player,
+		&weapon_system) != 0)
+		return (1);
+	if (args.load) /* Keep the tick length the save was made at */
+		args.tick_ms = weapon_system.tick_ms;
+	if (replay_record_start(&replay, args.record, args.seed, args.tick_ms))
+		return (1);
+	if (args.serve)
+		status = serve(&args, &game_state, &player, &weapon_system, &replay);
+	else
+	{
+		bot_init(&bot, args.seed);
+		start = SDL_GetPerformanceCounter();
+		for (tick = 0; tick < args.ticks; tick++)
+		{
+			bot_input(&bot, &input);
+			step_game(&game_state, &player, &weapon_system, &replay, &input);
+		}
+		ms = (SDL_GetPerformanceCounter() - start) * 1000.0 /
+			SDL_GetPerformanceFrequency();
+		printf("Seed %u: %ld ticks (%.1f s of play) in %.1f ms,"
+			" %.0f ticks/s\n", args.seed, args.ticks,
+			args.ticks * args.tick_ms / 1000.0, ms,
+			ms > 0 ? args.ticks * 1000.0 / ms : 0.0);
+	}
+	printf("Score %d, health %d, %d enemies left, state hash %08x\n",
+		weapon_system.score, weapon_system.player_health,
+		weapon_system.enemy_count,
+		game_state_hash(&game_state, &player, &weapon_system));
+	if (args.bench_save && bench_save(&game_state, &player,
+		&weapon_system) != 0)
+		status = -1;
+	if (args.save && save_file(args.save, &game_state, &player,
+		&weapon_system) != 0)
+		status = -1;
+	return ((replay_finish(&replay, game_state_hash(&game_state, &player,
+		&weapon_system)) != 0) | (status != 0));
+}
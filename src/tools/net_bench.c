@@ -0,0 +1,139 @@
+#include "../../inc/net.h"
+#include <string.h>
+
+#define NET_BENCH_TICKS 2000 /* Ticks served per client count */
+
+/**
+ * struct NetBench - The served game of one benchmark round
+ * @game_state: Game state
+ * @player: Player
+ * @weapon_system: Enemies and bullets
+ * @replay: Tick length; nothing is recorded
+ * @server: Server
+ * @bot: Bot playing through the first client
+ */
+typedef struct NetBench
+{
+	GameState game_state;
+	Player player;
+	WeaponSystem weapon_system;
+	Replay replay;
+	Server server;
+	Bot bot;
+} NetBench;
+
+/**
+ * bench_tick - Runs one server tick and lets every client answer
+ * @bench: Served game
+ * @clients: Clients; the first one plays with the bot's input
+ * @count: Number of clients
+ * Return: Performance counter ticks the server spent
+ *
+ * Client work is left out of the returned time.
+ */
+static Uint64 bench_tick(NetBench *bench, Client *clients, int count)
+{
+	Snapshot snapshot;
+	Input input;
+	Uint64 start = SDL_GetPerformanceCounter(), spent;
+	int i;
+
+	server_receive(&bench->server, bench->game_state.tick + 1, &input);
+	step_game(&bench->game_state, &bench->player, &bench->weapon_system,
+		&bench->replay, &input);
+	snapshot_capture(&snapshot, &bench->game_state, &bench->player,
+		&bench->weapon_system);
+	server_send(&bench->server, &snapshot);
+	spent = SDL_GetPerformanceCounter() - start;
+	for (i = 0; i < count; i++)
+	{
+		client_receive(&clients[i], snapshot.tick * bench->replay.tick_ms);
+		input.buttons = 0;
+		if (i == 0)
+			bot_input(&bench->bot, &input);
+		client_send(&clients[i], &input);
+	}
+	return (spent);
+}
+
+/**
+ * bench_round - Serves one client count over loopback and prints a row
+ * @count: Number of clients
+ * @clients: Room for @count clients
+ * @seed: Game seed
+ * @tick_ms: Simulation tick length
+ * Return: 0 if every client ended with the server's last snapshot,
+ * 1 if one did not, -1 if a socket could not be opened
+ */
+static int bench_round(int count, Client *clients, Uint32 seed,
+		Uint32 tick_ms)
+{
+	static NetBench bench;
+	Server *server = &bench.server;
+	char address[32];
+	Uint64 spent = 0;
+	Uint32 bytes = 0, full = 0, last;
+	int i, tick, synced = 0, status = 0;
+
+	if (server_start(server, 0, tick_ms) != 0)
+		return (-1);
+	snprintf(address, sizeof(address), "127.0.0.1:%d", server->port);
+	for (i = 0; i < count && status == 0; i++)
+		status = client_start(&clients[i], address);
+	replay_record_start(&bench.replay, NULL, seed, tick_ms);
+	game_init(&bench.game_state, &bench.player, &bench.weapon_system, seed);
+	bot_init(&bench.bot, seed);
+	for (tick = 0; tick < NET_BENCH_TICKS && status == 0; tick++)
+		spent += bench_tick(&bench, clients, count);
+	last = bench.game_state.tick & (NET_HISTORY - 1);
+	for (i = 0; i < count && status == 0; i++)
+	{
+		client_receive(&clients[i], bench.game_state.tick * tick_ms);
+		synced += memcmp(&clients[i].history[last], &server->history[last],
+			sizeof(Snapshot)) == 0;
+		bytes += server->peers[i].bytes;
+		full += server->peers[i].full;
+	}
+	if (status == 0)
+		printf("%7d %15.4f %15.1f %14.1f %5u   %d/%d\n", count,
+			spent * 1000.0 / SDL_GetPerformanceFrequency() / NET_BENCH_TICKS,
+			(double)bytes / count / NET_BENCH_TICKS,
+			bytes * 8.0 / count / NET_BENCH_TICKS / tick_ms,
+			(unsigned int)full, synced, count);
+	for (i = 0; i < count; i++)
+		client_stop(&clients[i]);
+	server_stop(server);
+	return (status != 0 ? -1 : synced != count);
+}
+
+/**
+ * run_net_bench - Measures snapshot bandwidth and server cost per client
+ * @max_clients: Largest client count; 1, 2, 4... up to it are measured
+ * @seed: Game seed, the same for every count
+ * @tick_ms: Simulation tick length
+ * Return: 0 if every client stayed in sync, 1 otherwise
+ *
+ * Server and clients share this process and talk over loopback UDP.
+ * A bot plays through the first client, the others only watch.
+ */
+int run_net_bench(int max_clients, Uint32 seed, Uint32 tick_ms)
+{
+	Client *clients = calloc(max_clients, sizeof(Client));
+	int count, status = 0;
+
+	if (!clients)
+		return (1);
+	printf("Snapshot server, %d ticks at %u ms over loopback UDP\n"
+		"clients  server ms/tick  bytes/snapshot  kbit/s/client  full"
+		"  in sync\n", NET_BENCH_TICKS, (unsigned int)tick_ms);
+	for (count = 1; status == 0; count *= 2)
+	{
+		if (count > max_clients)
+			count = max_clients;
+		status = bench_round(count, clients, seed, tick_ms);
+		if (count == max_clients)
+			break;
+	}
+	free(clients);
+	return (status != 0);
+}
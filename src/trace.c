@@ -0,0 +1,82 @@
+#include "../inc/maze.h"
+
+/**
+ * record_hit - Fills in where a ray entered a non-empty cell
+ * @hit: Hit whose type, side and cell are already set
+ * @origin: Ray origin (x, y)
+ * @dir: Ray direction (x, y)
+ * @distance: Distance at which the cell was entered
+ * @step: Signs of the ray direction (x, y)
+ */
+static void record_hit(WallHit *hit, const float *origin, const float *dir,
+			float distance, const int *step)
+{
+	float along;
+
+	hit->distance = distance;
+	along = hit->side == 0 ? origin[1] + dir[1] * distance :
+		origin[0] + dir[0] * distance;
+	hit->tex_x = along - floorf(along);
+	if (hit->side == 0)
+		hit->front_x -= step[0];
+	else
+		hit->front_y -= step[1];
+}
+
+/**
+ * trace_ray - Walks a ray cell by cell and collects what it hits
+ * @maze: Maze layout
+ * @player: Ray origin
+ * @angle: Ray angle
+ * @max_depth: Distance after which the ray gives up
+ * @hits: Receives up to MAX_WALL_HITS hits, nearest first
+ * Return: Number of hits; the last one is opaque if it is a wall or door
+ *
+ * A grid DDA visits every cell boundary the ray crosses. Empty cells cost
+ * one compare, so a column with a single wall costs no more than a plain
+ * traversal. Grates and low walls are recorded and the walk goes on, and
+ * the open part of a door lets the ray through.
+ */
+int trace_ray(const int maze[15][15], const Player *player, float angle,
+		float max_depth, WallHit *hits)
+{
+	float origin[2] = {player->x, player->y}, dir[2] = {cosf(angle),
+		sinf(angle)}, delta[2], next[2], distance;
+	int cell[2] = {(int)player->x, (int)player->y}, step[2], axis, type;
+	int count = 0;
+
+	for (axis = 0; axis < 2; axis++)
+	{
+		step[axis] = dir[axis] < 0 ? -1 : 1;
+		delta[axis] = dir[axis] != 0 ? fabsf(1.0f / dir[axis]) : 1e30f;
+		next[axis] = (dir[axis] < 0 ? origin[axis] - cell[axis] :
+			cell[axis] + 1 - origin[axis]) * delta[axis];
+	}
+	while (count < MAX_WALL_HITS)
+	{
+		axis = next[0] < next[1] ? 0 : 1;
+		distance = next[axis];
+		next[axis] += delta[axis];
+		cell[axis] += step[axis];
+		if (distance >= max_depth || cell[0] < 0 || cell[1] < 0 ||
+			cell[0] >= MAZE_COLS || cell[1] >= MAZE_ROWS)
+			break;
+		type = maze[cell[1]][cell[0]];
+		if (type == CELL_EMPTY)
+			continue;
+		hits[count].type = type;
+		hits[count].side = axis;
+		hits[count].front_x = cell[0];
+		hits[count].front_y = cell[1];
+		record_hit(&hits[count], origin, dir, distance, step);
+		/* A door slides aside; its open part lets the ray through */
+		if (type == CELL_DOOR)
+			hits[count].tex_x -= door_open[cell[1]][cell[0]] / (float)DOOR_OPEN;
+		if (type == CELL_DOOR && hits[count].tex_x < 0)
+			continue;
+		count++;
+		if (type == CELL_WALL || type == CELL_DOOR)
+			break;
+	}
+	return (count);
+}
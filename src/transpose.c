@@ -0,0 +1,102 @@
+#include "../inc/maze.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define TRANSPOSE_TILE 32 /* Side of the tiles transposed while in cache */
+
+/**
+ * transpose_block - Turns four column-major columns into four rows
+ * @src: Top of the first of the four columns
+ * @src_pitch: Distance between the columns, in pixels
+ * @dst: Left of the first of the four rows
+ * @dst_pitch: Distance between the rows, in pixels
+ *
+ * With SSE2 each column is one load and each row one store; the pixels
+ * are swapped across in registers with two rounds of unpacks.
+ */
+static void transpose_block(const Uint32 *src, int src_pitch, Uint32 *dst,
+		int dst_pitch)
+{
+#ifdef __SSE2__
+	__m128i c0 = _mm_loadu_si128((const __m128i *)src);
+	__m128i c1 = _mm_loadu_si128((const __m128i *)(src + src_pitch));
+	__m128i c2 = _mm_loadu_si128((const __m128i *)(src + 2 * src_pitch));
+	__m128i c3 = _mm_loadu_si128((const __m128i *)(src + 3 * src_pitch));
+	__m128i t0 = _mm_unpacklo_epi32(c0, c1), t1 = _mm_unpacklo_epi32(c2, c3);
+	__m128i t2 = _mm_unpackhi_epi32(c0, c1), t3 = _mm_unpackhi_epi32(c2, c3);
+
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(t0, t1));
+	_mm_storeu_si128((__m128i *)(dst + dst_pitch), _mm_unpackhi_epi64(t0, t1));
+	_mm_storeu_si128((__m128i *)(dst + 2 * dst_pitch),
+		_mm_unpacklo_epi64(t2, t3));
+	_mm_storeu_si128((__m128i *)(dst + 3 * dst_pitch),
+		_mm_unpackhi_epi64(t2, t3));
+#else
+	int x, y;
+
+	for (y = 0; y < 4; y++)
+		for (x = 0; x < 4; x++)
+			dst[y * dst_pitch + x] = src[x * src_pitch + y];
+#endif
+}
+
+/**
+ * transpose_tile - Transposes the whole 4x4 blocks of one tile
+ * @fb: Framebuffer
+ * @left: First column of the tile
+ * @top: First row of the tile
+ * @right: One past the last column, a multiple of 4
+ * @bottom: One past the last row, a multiple of 4
+ */
+static void transpose_tile(Framebuffer *fb, int left, int top, int right,
+		int bottom)
+{
+	int x, y;
+
+	for (x = left; x < right; x += 4)
+		for (y = top; y < bottom; y += 4)
+			transpose_block(fb->columns + x * fb->column_pitch + y,
+				fb->column_pitch, fb->pixels + y * fb->pitch + x, fb->pitch);
+}
+
+/**
+ * transpose_edges - Copies the pixels right of and below the whole blocks
+ * @fb: Framebuffer
+ * @width: Width covered by whole blocks
+ * @height: Height covered by whole blocks
+ *
+ * Whole-block stores there would run past the end of the rows.
+ */
+static void transpose_edges(Framebuffer *fb, int width, int height)
+{
+	int x, y;
+
+	for (y = 0; y < fb->height; y++)
+		for (x = y < height ? width : 0; x < fb->width; x++)
+			fb->pixels[y * fb->pitch + x] =
+				fb->columns[x * fb->column_pitch + y];
+}
+
+/**
+ * resolve_framebuffer - Turns the cast columns into presentable rows
+ * @fb: Framebuffer whose 3D view was just cast
+ *
+ * Nothing to do unless transposed. Otherwise the column-major scratch is
+ * transposed into pixels in TRANSPOSE_TILE square tiles, so the columns
+ * being read and the rows being written both stay in the L1 cache while
+ * a tile is done.
+ */
+void resolve_framebuffer(Framebuffer *fb)
+{
+	int width = fb->width & ~3, height = fb->height & ~3, x, y;
+
+	if (!fb->transposed)
+		return;
+	for (y = 0; y < height; y += TRANSPOSE_TILE)
+		for (x = 0; x < width; x += TRANSPOSE_TILE)
+			transpose_tile(fb, x, y, x + TRANSPOSE_TILE < width ?
+				x + TRANSPOSE_TILE : width, y + TRANSPOSE_TILE < height ?
+				y + TRANSPOSE_TILE : height);
+	transpose_edges(fb, width, height);
+}
@@ -0,0 +1,130 @@
+#include "../inc/fixed.h"
+
+/**
+ * view_init - Sets the projection of a view
+ * @view: View to initialize
+ * @fov: Horizontal field of view in degrees
+ * @max_depth: Maximum ray distance in cells
+ * @jobs: Render threads, or NULL to render on the calling thread
+ */
+void view_init(View *view, float fov, float max_depth, JobPool *jobs)
+{
+	view->fov = fov * (M_PI / 180.0);
+	view->max_depth = max_depth;
+	view->columns = 0;
+	view->capacity = 0;
+	view->ray_angle = NULL;
+	view->ray_turn = NULL;
+	view->rows = 0;
+	view->row_capacity = 0;
+	view->row_distance = NULL;
+	view->row_light = NULL;
+	view->row_fixed = NULL;
+	view->jobs = jobs;
+	view->fixed = 0;
+}
+
+/**
+ * view_update_rows - Rebuilds the floor distance and light tables
+ * @view: View
+ * @rows: Render height
+ * Return: 0 on success, -1 on allocation failure
+ *
+ * Every column sees the floor at the same distance through a given row,
+ * so the distance and its light level are looked up rather than computed
+ * per pixel. Rows at or above the horizon are never read.
+ */
+static int view_update_rows(View *view, int rows)
+{
+	float *distance;
+	Uint8 *light;
+	Sint32 *fixed;
+	int y;
+
+	if (rows > view->row_capacity)
+	{
+		distance = realloc(view->row_distance, sizeof(float) * rows);
+		if (distance)
+			view->row_distance = distance;
+		light = realloc(view->row_light, rows);
+		if (light)
+			view->row_light = light;
+		fixed = realloc(view->row_fixed, sizeof(Sint32) * rows);
+		if (fixed)
+			view->row_fixed = fixed;
+		if (!distance || !light || !fixed)
+			return (-1);
+		view->row_capacity = rows;
+	}
+	for (y = 0; y < rows; y++)
+	{
+		view->row_distance[y] = 2 * y > rows ?
+			(float)rows / (2.0f * y - rows) : view->max_depth;
+		view->row_light[y] = light_level(view->row_distance[y]);
+		view->row_fixed[y] = FIX_FROM_FLOAT(view->row_distance[y]);
+	}
+	view->rows = rows;
+	return (0);
+}
+
+/**
+ * view_update - Rebuilds the ray tables for a new render size
+ * @view: View
+ * @columns: Render width in columns
+ * @rows: Render height in rows
+ * Return: 0 on success, -1 on allocation failure
+ *
+ * Does nothing while the size is unchanged, and only reallocates when
+ * the size grows beyond every size seen before.
+ */
+int view_update(View *view, int columns, int rows)
+{
+	float *table;
+	Uint32 *turns;
+	int x;
+
+	if (rows != view->rows && view_update_rows(view, rows) != 0)
+		return (-1);
+	if (columns == view->columns)
+		return (0);
+	if (columns > view->capacity)
+	{
+		table = realloc(view->ray_angle, sizeof(float) * columns);
+		if (table)
+			view->ray_angle = table;
+		turns = realloc(view->ray_turn, sizeof(Uint32) * columns);
+		if (turns)
+			view->ray_turn = turns;
+		if (!table || !turns)
+			return (-1);
+		view->capacity = columns;
+	}
+	for (x = 0; x < columns; x++)
+	{
+		view->ray_angle[x] = -view->fov / 2 + x * view->fov / columns;
+		view->ray_turn[x] = (Uint32)(Sint32)(view->ray_angle[x] *
+			FIX_ANGLE_SCALE);
+	}
+	view->columns = columns;
+	return (0);
+}
+
+/**
+ * view_cleanup - Frees the ray tables
+ * @view: View to free
+ */
+void view_cleanup(View *view)
+{
+	free(view->ray_angle);
+	free(view->ray_turn);
+	free(view->row_distance);
+	free(view->row_light);
+	free(view->row_fixed);
+	view->ray_angle = NULL;
+	view->ray_turn = NULL;
+	view->row_distance = NULL;
+	view->row_light = NULL;
+	view->row_fixed = NULL;
+	view->columns = view->capacity = 0;
+	view->rows = view->row_capacity = 0;
+}
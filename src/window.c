@@ -0,0 +1,65 @@
+#include "../inc/session.h"
+
+/**
+ * framebuffer_resize - Reallocates the framebuffer for a new full size
+ * @fb: Framebuffer
+ * @renderer: SDL renderer that presents it
+ * @width: New largest render width
+ * @height: New largest render height
+ * Return: 0 on success, -1 on failure
+ *
+ * Only called when the size actually changes, never per frame. The new
+ * buffers and texture are allocated before the old ones are freed, so a
+ * failed resize leaves the framebuffer at its old size, still usable.
+ */
+int framebuffer_resize(Framebuffer *fb, SDL_Renderer *renderer,
+			int width, int height)
+{
+	Framebuffer next;
+
+	if (width == fb->max_width && height == fb->max_height)
+		return (0);
+	if (init_framebuffer(&next, renderer, width, height) != 0)
+		return (-1);
+	next.transposed = fb->transposed;
+	cleanup_framebuffer(fb);
+	*fb = next;
+	return (0);
+}
+
+/**
+ * framebuffer_set_size - Changes the render size within the allocation
+ * @fb: Framebuffer
+ * @width: New render width, clamped to [1, max_width]
+ * @height: New render height, clamped to [1, max_height]
+ */
+void framebuffer_set_size(Framebuffer *fb, int width, int height)
+{
+	fb->width = width < 1 ? 1 : width > fb->max_width ? fb->max_width : width;
+	fb->height = height < 1 ? 1 :
+		height > fb->max_height ? fb->max_height : height;
+}
+
+/**
+ * session_resize - Rebuilds the render buffers for a new window size
+ * @session: Session whose framebuffer is resized
+ * @width: New window width
+ * @height: New window height
+ *
+ * The render scale is kept, and the ray tables are rebuilt by the next
+ * cast_rays() call since the column count changes with the width.
+ */
+void session_resize(Session *session, int width, int height)
+{
+	int full_width = session->rays > 0 ? session->rays : width;
+
+	if (framebuffer_resize(&session->fb, session->renderer,
+		full_width, height) != 0)
+	{
+		printf("Framebuffer resize to %dx%d failed, keeping %dx%d\n",
+			full_width, height, session->fb.max_width,
+			session->fb.max_height);
+		return;
+	}
+	resolution_apply(&session->scaler, &session->fb);
+}